@@ -0,0 +1,223 @@
+# Generate the kernels of the reaction network from a reaction file
+#
+# Usage:
+#   cmake -DREACTION_FILE=<reactions.ini> -DOUTPUT_FILE=<header>
+#         [-DCOMPARTMENTS=cytosol;membrane]
+#         -P GenerateReactionNetworkKernels.cmake
+#
+# The reaction types of the given compartments are compiled in the same
+# way as ReactionNetwork does at run time: the reaction types are visited
+# in the order of their names, the species are numbered in the order of
+# their first appearance, and every direction with a nonzero rate constant
+# becomes a channel. The generated header holds the species indices, the
+# stoichiometry table and the unrolled propensity and update functions.
+
+if(NOT DEFINED COMPARTMENTS)
+    set(COMPARTMENTS cytosol membrane)
+endif()
+
+# Read the reaction file into a list of lines without comments.
+file(READ ${REACTION_FILE} content)
+string(REGEX REPLACE ";[^\n]*" "" content "${content}")
+string(REPLACE "\r" "" content "${content}")
+string(REPLACE "\n" ";" lines "${content}")
+
+# Parse the reaction types with the same five-line layout as
+# initializeReactionTypeTable.
+string(ASCII 1 separator)
+set(compartment "")
+set(line_cnt 0)
+set(reaction_num 0)
+set(sorted_reactions "")
+foreach(line IN LISTS lines)
+    string(STRIP "${line}" line)
+    if(line STREQUAL "")
+        continue()
+    endif()
+    if(line MATCHES "^\\[([^]]*)\\]")
+        set(compartment "${CMAKE_MATCH_1}")
+        continue()
+    endif()
+    string(REGEX REPLACE "^[^=]*=" "" value "${line}")
+    if(line_cnt EQUAL 0)
+        set(name "${value}")
+    elseif(line_cnt EQUAL 1)
+        string(REPLACE "," ";" reactants "${value}")
+    elseif(line_cnt EQUAL 2)
+        string(REPLACE "," ";" products "${value}")
+    elseif(line_cnt EQUAL 3)
+        set(forward_const "${value}")
+    else()
+        set(backward_const "${value}")
+        list(FIND COMPARTMENTS "${compartment}" compartment_index)
+        if(NOT compartment_index EQUAL -1)
+            set(reaction_${reaction_num}_reactants "${reactants}")
+            set(reaction_${reaction_num}_products "${products}")
+            set(reaction_${reaction_num}_forward_const "${forward_const}")
+            set(reaction_${reaction_num}_backward_const "${backward_const}")
+            list(APPEND sorted_reactions "${name}${separator}${reaction_num}")
+            math(EXPR reaction_num "${reaction_num} + 1")
+        endif()
+        set(line_cnt -1)
+    endif()
+    math(EXPR line_cnt "${line_cnt} + 1")
+endforeach()
+list(SORT sorted_reactions)
+
+# Number the species and collect the channels.
+set(species "")
+set(channel_num 0)
+foreach(sorted_reaction IN LISTS sorted_reactions)
+    string(REGEX REPLACE "^.*${separator}" "" r "${sorted_reaction}")
+    foreach(s IN LISTS reaction_${r}_reactants reaction_${r}_products)
+        list(FIND species "${s}" species_index)
+        if(species_index EQUAL -1)
+            list(APPEND species "${s}")
+        endif()
+    endforeach()
+    if(reaction_${r}_forward_const GREATER 0)
+        set(channel_${channel_num}_reactants "${reaction_${r}_reactants}")
+        set(channel_${channel_num}_products "${reaction_${r}_products}")
+        math(EXPR channel_num "${channel_num} + 1")
+    endif()
+    if(reaction_${r}_backward_const GREATER 0)
+        set(channel_${channel_num}_reactants "${reaction_${r}_products}")
+        set(channel_${channel_num}_products "${reaction_${r}_reactants}")
+        math(EXPR channel_num "${channel_num} + 1")
+    endif()
+endforeach()
+list(LENGTH species species_num)
+
+# Write the species indices and names.
+set(code "")
+string(APPEND code "// Generated from ${REACTION_FILE} by GenerateReactionNetworkKernels.cmake.\n")
+string(APPEND code "// Do not edit.\n\n")
+string(APPEND code "#ifndef REACTIONNETWORKKERNELS_HPP_\n#define REACTIONNETWORKKERNELS_HPP_\n\n#include <cstddef>\n\nnamespace motility\n{\n\nnamespace kernels\n{\n\n")
+string(APPEND code "constexpr size_t species_num = ${species_num};\n\nconstexpr size_t channel_num = ${channel_num};\n\n")
+set(i 0)
+set(names "")
+foreach(s IN LISTS species)
+    string(REPLACE "*" "star" identifier "${s}")
+    string(MAKE_C_IDENTIFIER "${identifier}" identifier)
+    string(APPEND code "constexpr size_t species_${identifier} = ${i};\n")
+    string(APPEND names "\t\"${s}\",\n")
+    math(EXPR i "${i} + 1")
+endforeach()
+string(APPEND code "\nconstexpr const char* species_names[species_num] =\n{\n${names}};\n\n")
+
+# Write the stoichiometry table and the unrolled kernels of each channel.
+set(stoichiometry "")
+set(propensity_cases "")
+set(propensity_lines "")
+set(fire_cases "")
+math(EXPR last_channel "${channel_num} - 1")
+foreach(c RANGE ${last_channel})
+    if(channel_num EQUAL 0)
+        break()
+    endif()
+    # The propensity multiplies the falling factorial of the count of
+    # each reactant species by its multiplicity.
+    set(propensity "k[${c}]")
+    set(seen "")
+    foreach(s IN LISTS channel_${c}_reactants)
+        list(FIND species "${s}" i)
+        set(m 0)
+        foreach(t IN LISTS seen)
+            if(t EQUAL i)
+                math(EXPR m "${m} + 1")
+            endif()
+        endforeach()
+        list(APPEND seen ${i})
+        if(m EQUAL 0)
+            string(APPEND propensity " * n[${i}]")
+        else()
+            string(APPEND propensity " * (n[${i}] - ${m})")
+        endif()
+    endforeach()
+    string(APPEND propensity_cases "\t\tcase ${c}: return ${propensity};\n")
+    string(APPEND propensity_lines "\ta[${c}] = ${propensity};\n")
+    # The net change of each species.
+    set(row "")
+    set(updates "")
+    math(EXPR last_species "${species_num} - 1")
+    foreach(i RANGE ${last_species})
+        list(GET species ${i} s)
+        set(change 0)
+        foreach(t IN LISTS channel_${c}_reactants)
+            if(t STREQUAL s)
+                math(EXPR change "${change} - 1")
+            endif()
+        endforeach()
+        foreach(t IN LISTS channel_${c}_products)
+            if(t STREQUAL s)
+                math(EXPR change "${change} + 1")
+            endif()
+        endforeach()
+        list(APPEND row ${change})
+        set(channel_${c}_change_${i} ${change})
+        if(change GREATER 0)
+            string(APPEND updates " n[${i}] += ${change};")
+        elseif(change LESS 0)
+            string(REPLACE "-" "" magnitude "${change}")
+            string(APPEND updates " n[${i}] -= ${magnitude};")
+        endif()
+    endforeach()
+    string(REPLACE ";" ", " row "${row}")
+    string(APPEND stoichiometry "\t{ ${row} },\n")
+    string(APPEND fire_cases "\t\tcase ${c}:${updates} break;\n")
+endforeach()
+set(leap_lines "")
+if(species_num GREATER 0)
+    math(EXPR last_species "${species_num} - 1")
+    foreach(i RANGE ${last_species})
+        set(terms "")
+        foreach(c RANGE ${last_channel})
+            if(channel_num EQUAL 0)
+                break()
+            endif()
+            set(change ${channel_${c}_change_${i}})
+            if(change EQUAL 1)
+                string(APPEND terms " + f[${c}]")
+            elseif(change EQUAL -1)
+                string(APPEND terms " - f[${c}]")
+            elseif(change GREATER 0)
+                string(APPEND terms " + ${change} * f[${c}]")
+            elseif(change LESS 0)
+                string(REPLACE "-" "" magnitude "${change}")
+                string(APPEND terms " - ${magnitude} * f[${c}]")
+            endif()
+        endforeach()
+        if(NOT terms STREQUAL "")
+            string(REGEX REPLACE "^ \\+ " "" terms "${terms}")
+            string(REGEX REPLACE "^ - " "-" terms "${terms}")
+            string(APPEND leap_lines "\tn[${i}] += ${terms};\n")
+        endif()
+    endforeach()
+endif()
+
+string(APPEND code "/// The net change of the count of each species when a channel fires.\n")
+string(APPEND code "constexpr long stoichiometry[channel_num > 0 ? channel_num : 1][species_num > 0 ? species_num : 1] =\n{\n${stoichiometry}};\n\n")
+string(APPEND code "/// This function returns the propensity of channel c, given the\n/// stochastic rate constants k and the counts n of all species.\n")
+string(APPEND code "inline double propensity(size_t c, const double* k, const long* n)\n{\n\tswitch(c)\n\t{\n${propensity_cases}\t\tdefault: return 0;\n\t}\n}\n\n")
+# Mark the arguments of the functions with empty bodies as unused.
+if(channel_num EQUAL 0)
+    set(propensity_lines "\t(void)k; (void)n; (void)a;\n")
+    set(leap_lines "\t(void)f; (void)n;\n")
+endif()
+string(APPEND code "/// This function computes the propensities a of all channels.\n")
+string(APPEND code "inline void propensities(const double* k, const long* n, double* a)\n{\n${propensity_lines}}\n\n")
+string(APPEND code "/// This function fires channel c once.\n")
+string(APPEND code "inline void fire(size_t c, long* n)\n{\n\tswitch(c)\n\t{\n${fire_cases}\t\tdefault: break;\n\t}\n}\n\n")
+string(APPEND code "/// This function fires every channel c by f[c] times.\n")
+string(APPEND code "inline void fire(const long* f, long* n)\n{\n${leap_lines}}\n\n")
+string(APPEND code "}\n\n}\n\n#endif /*REACTIONNETWORKKERNELS_HPP_*/\n")
+
+# Only touch the header when its content changes.
+if(EXISTS ${OUTPUT_FILE})
+    file(READ ${OUTPUT_FILE} old_code)
+else()
+    set(old_code "")
+endif()
+if(NOT old_code STREQUAL code)
+    file(WRITE ${OUTPUT_FILE} "${code}")
+endif()
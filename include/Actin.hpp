@@ -24,6 +24,8 @@ class Actin : public Molecule
 	const char* getBoundState() const;
 
 	void setBoundState(const char* s);
+
+	friend class CompactFilament;
 };
 
 inline ActinHandle actin_handle_null {};
@@ -23,18 +23,48 @@ class BranchTree
 	/// a given filament.
 	BranchTree(const FilamentBranch& branch);
 
+	/// This constructor creates a new actin filament tree by
+	/// moving a given filament into it.
+	BranchTree(FilamentBranch&& branch);
+
 	virtual ~BranchTree();
 
-	/// This constructor adds a new actin filament into current
-	/// filament tree.
+	/// This function constructs a new actin filament in place
+	/// at the end of current filament tree.
 	void addFilamentBranch(const ARP23& arp23, const Actin& actin, const Orientation& orient, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle);
 
-	/// This constructor adds a new actin filament into current
+	/// This function adds a new actin filament into current
 	/// filament tree.
 	void addFilamentBranch(const FilamentBranch& branch, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle);
 
+	/// This function moves a new actin filament into current
+	/// filament tree.
+	void addFilamentBranch(FilamentBranch&& branch, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle);
+
+	/// This function removes an actin filament, which holds no child
+	/// filament, from current filament tree. The filament is unlinked
+	/// from its parent filament and from its vertex on cell membrane
+	/// surface.
 	void removeFilamentBranch(FilamentBranchHandle fbh);
 
+	/// This function moves the subtree rooted at an actin filament of
+	/// current filament tree into a new filament tree, where the
+	/// filament becomes the root.
+	///
+	/// \param fbh the handle of the root filament of the subtree.
+	/// \param tree_handle the handle of the new empty filament tree.
+	void moveFilamentSubtree(FilamentBranchHandle fbh, BranchTreeHandle tree_handle);
+
+	/// This function severs an actin filament before its k-th actin
+	/// monomer. The distal part of the filament becomes the root of a
+	/// new filament tree, into which the subtrees of the child filaments
+	/// located on the distal part are moved.
+	///
+	/// \param fbh the handle of the filament to be severed.
+	/// \param k the number of actin monomers kept by the filament.
+	/// \param tree_handle the handle of the new empty filament tree.
+	void severFilamentBranch(FilamentBranchHandle fbh, size_t k, BranchTreeHandle tree_handle);
+
 	bool isEmpty() const;
 
 	FilamentBranches& getBranches();
@@ -42,6 +72,21 @@ class BranchTree
 	FilamentBranchHandle getFirstBranchHandle();
 
 	FilamentBranchHandle getLastBranchHandle();
+
+  private:
+
+	/// This function unlinks an actin filament from its parent filament
+	/// and from its vertex on cell membrane surface.
+	void unlinkFilamentBranch(FilamentBranchHandle fbh);
+
+	/// This function links the last filament of current filament
+	/// tree to its parent filament.
+	void linkLastFilamentBranch(FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle);
+
+	/// This function moves the subtrees of the child filaments of the
+	/// filaments in a new filament tree from current filament tree into
+	/// the new one.
+	void spliceChildSubtrees(BranchTreeHandle tree_handle);
 };
 
 inline BranchTreeHandle branch_tree_handle_null {};
@@ -2,7 +2,7 @@
 #define CELLSTATISTICSCALCULATOR_HPP_
 
 #include <string>
-#include <UniformMolecularDistribution.hpp>
+#include <MolecularDistribution.hpp>
 #include <OutputFile.hpp>
 
 namespace motility
@@ -60,20 +60,20 @@ class CellStatisticsCalculator
 
   private:
 
-	void collectSpreadingProperty(MotileCell* cell, UniformMolecularDistribution* ecs_dist, size_t* n_filament, double* radii, size_t* n_growing_filament, double* growing_percent, double* deviation_angles, size_t* n_outward_filament, double* outward_percent);
+	void collectSpreadingProperty(MotileCell* cell, MolecularDistribution* ecs_dist, size_t* n_filament, double* radii, size_t* n_growing_filament, double* growing_percent, double* deviation_angles, size_t* n_outward_filament, double* outward_percent);
 
 	void computeSpreadingVelocity(double* radii, double* new_radii, double dt, double* spreading_velocity);
 
   public:
 
 	/// The constructor initialize various variables needed to calculate cell statistics.
-	CellStatisticsCalculator(MotileCell* cell, UniformMolecularDistribution* ecs_dist, double t, const std::string& data_dir);
+	CellStatisticsCalculator(MotileCell* cell, MolecularDistribution* ecs_dist, double t, const std::string& data_dir);
 
 	/// The destructor clean up used memory and close data files.
 	virtual ~CellStatisticsCalculator();
 
 	/// The function-like interface for main program to call.
-	void operator()(MotileCell* cell, UniformMolecularDistribution* ecs_dist, double t, bool file_saving_flag);
+	void operator()(MotileCell* cell, MolecularDistribution* ecs_dist, double t, bool file_saving_flag);
 };
 
 }
@@ -0,0 +1,175 @@
+#ifndef COMPACTFILAMENT_HPP_
+#define COMPACTFILAMENT_HPP_
+
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <typedefs.hpp>
+#include <Coordinate.hpp>
+#include <Vector.hpp>
+#include <Actin.hpp>
+
+namespace motility
+{
+
+/// CompactFilament class stores the actin monomers of a filament
+/// branch in compact form.
+///
+///
+/// Rationale
+///
+/// The monomers of a filament are stacked one after another from
+/// the pointed end to the barbed end along the orientation of the
+/// filament, so the location of each monomer is determined by the
+/// location of the first monomer (the anchor), the orientation and
+/// the monomer diameter. Only these quantities and the count of
+/// monomers are stored, and the locations are computed on demand.
+///
+/// The nucleotide and bound states of neighboring monomers are mostly
+/// identical, so they are stored as runs of equal states counted from
+/// the pointed end. The memory of a filament is therefore independent
+/// of its length in the common case.
+///
+/// An Actin instance of a given monomer is only materialized when it
+/// is requested, e.g. through the iterator of this class.
+///
+/// The nucleotides of polymerized monomers age from ATP to ADP-Pi
+/// by hydrolysis and then to ADP by Pi release. Instead of simulating
+/// these transitions monomer by monomer, the number of transitions in
+/// a period of time is sampled in aggregate for the whole filament,
+/// and the monomers closest to the pointed end, i.e. the oldest ones,
+/// transit first. The filament therefore always consists of at most
+/// three segments, ADP, ADP-Pi and ATP from the pointed end, and the
+/// aging only advances the boundaries between these segments.
+class CompactFilament
+{
+	/// A run of consecutive monomers with the same states.
+	struct Run
+	{
+		std::uint8_t state;
+
+		std::uint8_t bound_state;
+
+		std::uint32_t length;
+	};
+
+	/// The location of the monomer at the pointed end.
+	CartesianCoordinate anchor;
+
+	/// The unit vector from the pointed end to the barbed end.
+	Vector direction;
+
+	/// The diameter shared by all monomers.
+	double diameter;
+
+	size_t count;
+
+	std::vector<Run> runs;
+
+  private:
+
+	/// This function returns the run containing a given monomer.
+	const Run& getRun(size_t i) const;
+
+	/// This function assigns ADP to the first 'adp' monomers, ADP-Pi
+	/// to the following 'adpi' monomers and ATP to the rest, while the
+	/// bound states are kept.
+	void setNucleotideBoundaries(size_t adp, size_t adpi);
+
+  public:
+
+	/// The iterator of CompactFilament materializes each monomer
+	/// as an Actin value from the pointed end to the barbed end.
+	class const_iterator
+	{
+		const CompactFilament* filament;
+
+		size_t index;
+
+	  public:
+
+		typedef std::forward_iterator_tag iterator_category;
+
+		typedef Actin value_type;
+
+		typedef std::ptrdiff_t difference_type;
+
+		typedef const Actin* pointer;
+
+		typedef Actin reference;
+
+		const_iterator(const CompactFilament* f = nullptr, size_t i = 0) : filament(f), index(i) {}
+
+		Actin operator*() const { return filament->getActin(index); }
+
+		const_iterator& operator++() { ++index; return *this; }
+
+		const_iterator operator++(int) { const_iterator it = *this; ++index; return it; }
+
+		bool operator==(const const_iterator& it) const { return (filament == it.filament && index == it.index); }
+
+		bool operator!=(const const_iterator& it) const { return !(*this == it); }
+	};
+
+	CompactFilament();
+
+	/// This function sets the location of the monomer at the pointed
+	/// end and the unit direction vector of an empty filament.
+	void setAnchor(const CartesianCoordinate& loc, const Vector& dir);
+
+	/// This function appends a monomer at the barbed end. Only the
+	/// states and the diameter of the given actin are used, and the
+	/// diameter must be the same for all monomers.
+	void push_back(const Actin& actin);
+
+	/// This function removes the monomer at the barbed end.
+	void pop_back();
+
+	void clear();
+
+	bool empty() const;
+
+	size_t size() const;
+
+	double getDiameter() const;
+
+	/// This function returns the location of the i-th monomer counted
+	/// from the pointed end, starting from zero.
+	CartesianCoordinate getLocation(size_t i) const;
+
+	const char* getState(size_t i) const;
+
+	const char* getBoundState(size_t i) const;
+
+	/// This function materializes the i-th monomer counted from the
+	/// pointed end as an immobile Actin instance.
+	Actin getActin(size_t i) const;
+
+	Actin front() const;
+
+	Actin back() const;
+
+	/// This function returns the number of monomers in a given
+	/// nucleotide state, encoded as in Actin.
+	size_t countState(std::uint8_t state) const;
+
+	/// This function splits the filament before the k-th monomer.
+	/// The first k monomers are kept and the rest are returned as a
+	/// new filament, in the time proportional to the number of runs.
+	CompactFilament split(size_t k);
+
+	/// This function ages the nucleotides of all monomers over a period
+	/// of time with given rate constants of ATP hydrolysis and Pi
+	/// release, using a random engine separate from the one driving the
+	/// reaction events.
+	void age(double period, double hydrolysis_rate, double release_rate, std::mt19937& engine);
+
+	const_iterator begin() const;
+
+	const_iterator end() const;
+};
+
+}
+
+#endif /*COMPACTFILAMENT_HPP_*/
@@ -4,7 +4,9 @@
 #include <cfloat>
 #include <cmath>
 #include <list>
+#include <memory_resource>
 #include <iostream>
+#include <Vec3.hpp>
 
 namespace motility
 {
@@ -23,25 +25,34 @@ struct CartesianCoordinate
 
 	CartesianCoordinate(const CylindricalCoordinate& cc);
 
+	/// These functions convert a point to and from the vector from the
+	/// origin used by the geometric kernels.
+	CartesianCoordinate(const Vec3d& v) : x(v.x), y(v.y), z(v.z) {}
+
+	Vec3d toVec3() const
+	{
+		return Vec3d(x, y, z);
+	}
+
 	const SphericalCoordinate toSphericalCoordinate() const;
 
 	const CylindricalCoordinate toCylindricalCoordinate() const;
 
 	const CartesianCoordinate& operator+() const;
 
-	const CartesianCoordinate operator-() const;
+	CartesianCoordinate operator-() const;
 
-	const CartesianCoordinate operator+(const CartesianCoordinate& cc) const;
+	CartesianCoordinate operator+(const CartesianCoordinate& cc) const;
 
-	const CartesianCoordinate operator-(const CartesianCoordinate& cc) const;
+	CartesianCoordinate operator-(const CartesianCoordinate& cc) const;
 
 	CartesianCoordinate& operator+=(const CartesianCoordinate& cc);
 
 	CartesianCoordinate& operator-=(const CartesianCoordinate& cc);
 
-	const CartesianCoordinate operator*(double c) const;
+	CartesianCoordinate operator*(double c) const;
 
-	const CartesianCoordinate operator/(double c) const;
+	CartesianCoordinate operator/(double c) const;
 
 	CartesianCoordinate& operator*=(double c);
 
@@ -156,35 +167,35 @@ struct GridCoordinate
 	GridCoordinate(size_t ii = 0, size_t jj = 0, size_t kk = 0);
 };
 
-typedef std::list<CartesianCoordinate> CartesianCoordinates;
+typedef std::pmr::list<CartesianCoordinate> CartesianCoordinates;
 typedef CartesianCoordinates::iterator CartesianCoordinateHandle;
 typedef CartesianCoordinates::const_iterator CartesianCoordinateConstHandle;
 
 inline CartesianCoordinateHandle cartesian_coordinate_handle_null {};
 inline CartesianCoordinateConstHandle cartesian_coordinate_const_handle_null {};
 
-typedef std::list<SphericalCoordinate> SphericalCoordinates;
+typedef std::pmr::list<SphericalCoordinate> SphericalCoordinates;
 typedef SphericalCoordinates::iterator SphericalCoordinateHandle;
 typedef SphericalCoordinates::const_iterator SphericalCoordinateConstHandle;
 
 inline SphericalCoordinateHandle spherical_coordinate_handle_null {};
 inline SphericalCoordinateConstHandle spherical_coordinate_const_handle_null {};
 
-typedef std::list<CylindricalCoordinate> CylindricalCoordinates;
+typedef std::pmr::list<CylindricalCoordinate> CylindricalCoordinates;
 typedef CylindricalCoordinates::iterator CylindricalCoordinateHandle;
 typedef CylindricalCoordinates::const_iterator CylindricalCoordinateConstHandle;
 
 inline CylindricalCoordinateHandle cylindrical_coordinate_handle_null {};
 inline CylindricalCoordinateConstHandle cylindrical_coordinate_const_handle_null {};
 
-typedef std::list<Orientation> Orientations;
+typedef std::pmr::list<Orientation> Orientations;
 typedef Orientations::iterator OrientationHandle;
 typedef Orientations::const_iterator OrientationConstHandle;
 
 inline OrientationHandle orientation_handle_null {};
 inline OrientationConstHandle orientation_const_handle_null {};
 
-typedef std::list<GridCoordinate> GridCoordinates;
+typedef std::pmr::list<GridCoordinate> GridCoordinates;
 typedef GridCoordinates::iterator GridCoordinateHandle;
 typedef GridCoordinates::const_iterator GridCoordinateConstHandle;
 
@@ -2,17 +2,18 @@
 #define DISCRETEEVENT_HPP_
 
 #include <list>
+#include <memory_resource>
 #include <Event.hpp>
 
 namespace simulation
 {
 
 class DiscreteEvent;
-typedef std::list<DiscreteEvent*> DiscreteEvents;
+typedef std::pmr::list<DiscreteEvent*> DiscreteEvents;
 typedef DiscreteEvents::iterator DiscreteEvent_iterator;
-typedef std::list<DiscreteEvent_iterator> DiscreteEvent_iterators;
+typedef std::pmr::list<DiscreteEvent_iterator> DiscreteEvent_iterators;
 typedef DiscreteEvent_iterators::iterator DiscreteEvent_iterator_iterator;
-typedef std::list<DiscreteEvent_iterator_iterator> DiscreteEvent_iterator_iterators;
+typedef std::pmr::list<DiscreteEvent_iterator_iterator> DiscreteEvent_iterator_iterators;
 typedef DiscreteEvent_iterator_iterators::iterator DiscreteEvent_iterator_iterator_iterator;
 
 class DiscreteEvent : public Event
@@ -70,8 +70,8 @@ class DiscreteEventSimulator : public EventSimulator
 	/// executed event before its action is executed.
 	double exec(DiscreteEvent_iterator event_ptr);
 
-	/// Bubble sorting algorithm.
-	void bubble_sort(DiscreteEvent_iterators& events);
+	/// Stable merge sorting algorithm in O(n log n) time.
+	void merge_sort(DiscreteEvent_iterators& events);
 
 	/// This function finds the position to insert an event in order
 	/// to maintain an event list sorted from the minimum period to
@@ -207,6 +207,11 @@ class DiscreteEventSimulator : public EventSimulator
 	/// Remove the connection of an event with all other events.
 	void remove_connection(DiscreteEvent_iterator event_ptr);
 
+	/// Update the rates and the periods of all events, e.g. after
+	/// the environment shared by all events changes, and sort them
+	/// again.
+	void refresh_events();
+
 	/// These functions are inheried from EventSimulator such that
 	/// derived class can make use of them.
 
@@ -58,6 +58,11 @@ class EventSimulator
 	/// This function must be defined in derived simulator class.
 	virtual double update() = 0;
 
+	/// This function advances the continuous processes coupled with
+	/// the events up to the current time moment. It is called after
+	/// each simulation step, before the information is recorded.
+	virtual void integrate();
+
 	/// The simulator constructor for continuous-time event.
 	EventSimulator(double max_duration, double time_step, double record_time_interval, size_t record_step_interval);
 
@@ -0,0 +1,99 @@
+#ifndef FACETGRID_HPP_
+#define FACETGRID_HPP_
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <typedefs.hpp>
+#include <Coordinate.hpp>
+#include <Line.hpp>
+#include <VertexEdgeFacet.hpp>
+
+namespace motility
+{
+
+/// FacetGrid class is a spatial index over the facets of cell membrane.
+///
+///
+/// Purpose
+///
+/// The local searches of SurfaceTopology only look at the neighborhood
+/// of a given facet. FacetGrid answers the global queries, e.g. which
+/// facets a line segment may cross, without scanning the whole facet pool.
+///
+///
+/// Logical design
+///
+/// The space is partitioned into a hashed uniform grid of cubic cells
+/// whose size is comparable to the mean edge length of membrane surface.
+/// Each facet is registered in all cells overlapped by its bounding box,
+/// and the range of these cells is recorded in the facet itself. The grid
+/// is updated incrementally when a facet is added, removed or moved, and
+/// it is rebuilt from scratch when the mean edge length drifts away from
+/// the cell size.
+///
+/// The queries only return candidate facets, i.e. the facets whose bounding
+/// boxes overlap the searched cells. The exact geometric tests are left to
+/// the caller.
+class FacetGrid
+{
+	typedef std::uint64_t CellKey;
+
+	typedef std::vector<FacetHandle> CellFacets;
+
+	/// The size of grid cells. Zero means the grid is not built.
+	double cell_size;
+
+	/// The registered facets of each occupied cell.
+	std::unordered_map<CellKey, CellFacets> cells;
+
+	/// The stamp used to report each facet only once per query.
+	mutable size_t query_stamp;
+
+  private:
+
+	long getCellIndex(double x) const;
+
+	CellKey getCellKey(long i, long j, long k) const;
+
+	void collectCellFacets(long i, long j, long k, FacetHandles& candidates) const;
+
+	void computeCellRange(FacetHandle fh, long* range) const;
+
+  public:
+
+	FacetGrid();
+
+	/// This function returns whether or not the grid has been built.
+	bool isBuilt() const;
+
+	double getCellSize() const;
+
+	/// This function rebuilds the grid from all given facets.
+	///
+	/// \param facets the facet pool of membrane surface.
+	/// \param size the size of grid cells.
+	/// \return No returned value.
+	void rebuild(Facets& facets, double size);
+
+	/// This function registers a new facet into the grid.
+	void insert(FacetHandle fh);
+
+	/// This function unregisters a facet from the grid.
+	void remove(FacetHandle fh);
+
+	/// This function re-registers a facet whose vertices have moved. Nothing
+	/// is done if the facet still overlaps the same range of cells.
+	void update(FacetHandle fh);
+
+	/// This function returns the candidate facets which a line segment may
+	/// cross. The cells pierced by the segment are traversed one by one.
+	///
+	/// \param l the line segment.
+	/// \return The handles of candidate facets.
+	FacetHandles getCandidateFacetHandles(Line& l) const;
+};
+
+}
+
+#endif /*FACETGRID_HPP_*/
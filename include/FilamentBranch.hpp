@@ -2,8 +2,11 @@
 #define FILAMENTBRANCH_HPP_
 
 #include <cassert>
+#include <optional>
 #include <typedefs.hpp>
 #include <Actin.hpp>
+#include <CompactFilament.hpp>
+#include <FilamentStateTable.hpp>
 #include <ARP23.hpp>
 #include <CAP.hpp>
 #include <VertexEdgeFacet.hpp>
@@ -20,20 +23,22 @@ namespace motility
 /// The data structure of actin filament contains all necessary
 /// components to integrate individual filaments into filament
 /// tree and to facilitate filament-related biochemical reactions.
+///
+/// The hot state of a filament, i.e. the locations of both ends,
+/// the direction, the capping flag and the vertex, is kept in the
+/// dense FilamentStateTable under the id of this filament. This
+/// class itself holds the cold topological and bookkeeping data.
 
 class FilamentBranch
 {
   private:
 
-	Actins filament;
-
-	/// The pointer to corresponding vertex on cell membrane
-	/// surface.
-	VertexHandle vertex;
+	/// The id of the hot state of this filament in FilamentStateTable.
+	size_t id;
 
-	/// This variable indicates whether current actin filament
-	/// is attached to cell membrane.
-	bool membrane_attachment;
+	/// The actin monomers of this filament, from the pointed end
+	/// to the barbed end.
+	CompactFilament filament;
 
 	/// This variable indicates whether current actin filament
 	/// is linked to cell membrane.
@@ -41,14 +46,17 @@ class FilamentBranch
 
 	double branching_angle;
 
+	/// The number of actin monomers on mother filament bound by
+	/// the ARP23 molecule of a child filament.
+	size_t arp23_binding_actins;
+
 	Orientation orient;
 
-	/// This class uses two pointers to manage the presence of
-	/// Arp23 and capping protein for current actin filament,
-	/// including their memory management.
-	ARP23* arp23_handle;
+	/// The Arp23 and capping protein of current actin filament
+	/// are held by value and are only present when bound.
+	std::optional<ARP23> arp23;
 
-	CAP* cap_handle;
+	std::optional<CAP> cap;
 
 	/// The pointer to the associated tree.
 	BranchTreeHandle tree_handle;
@@ -56,6 +64,10 @@ class FilamentBranch
 	/// The pointer to the parent actin filament.
 	FilamentBranchHandle parent_handle;
 
+	/// The generational handle of the parent actin filament, with
+	/// which the validity of parent_handle is checked in constant time.
+	FilamentId parent_id;
+
 	/// The position of current actin filament in the list of
 	/// the child filaments of the parent filament, starting
 	/// from zero.
@@ -65,7 +77,13 @@ class FilamentBranch
 
 	/// The position to which current actin filament is attached
 	/// on the parent filament, starting from zero.
-	std::list<size_t> child_locations;
+	std::pmr::list<size_t> child_locations;
+
+	/// The position of the last child filament in the list of child
+	/// locations, which is zero if the filament has no child filament.
+	/// It follows the list when a child filament is removed or moved
+	/// away by severing.
+	size_t last_child_location;
 
 	/// The flag indicating the allowance of branching a child
 	/// filament.
@@ -83,6 +101,10 @@ class FilamentBranch
 	/// The initial lenght of this filament.
 	double initial_length;
 
+	/// The time up to which the nucleotides of the monomers of this
+	/// filament have been aged.
+	double nucleotide_time;
+
 	/// These three variables are defined for the member function
 	/// perturbTailEndLocation and restoreTailEndLocation.
 	bool virtual_tail_end;
@@ -95,24 +117,37 @@ class FilamentBranch
 
   private:
 
-	void initializeMemory(const ARP23& arp23);
-
-	void clearMemory();
+	CartesianCoordinate getLocationOfTheOtherEnd(const CartesianCoordinate& loc, double dist) const;
 
-	void copyMemory(const FilamentBranch& fb);
+	/// This function updates the cached locations of both ends and
+	/// the diameter of the molecule at the tail end, whenever a
+	/// molecule is added to or removed from this filament.
+	void updateEndLocations();
 
-	CartesianCoordinate getLocationOfTheOtherEnd(const CartesianCoordinate& loc, double dist, const Orientation& ot) const;
+	FilamentState& getState() const;
 
   public:
 
 	FilamentBranch();
 
-	FilamentBranch(const ARP23& arp23, const Actin& actin, const Orientation& ot);
+	FilamentBranch(const ARP23& a, const Actin& actin, const Orientation& ot);
 
+	/// A filament branch is moved rather than copied when it is
+	/// added into a filament tree. A copied filament acquires a new
+	/// id with a copy of the hot state, while a moved filament takes
+	/// over the id of the source.
 	FilamentBranch(const FilamentBranch& fb);
 
+	FilamentBranch(FilamentBranch&& fb);
+
 	~FilamentBranch();
 
+	/// This function returns the id of the hot state of this filament.
+	size_t getId() const;
+
+	/// This function returns the generational handle of this filament.
+	FilamentId getHandle() const;
+
 	VertexHandle getVertex();
 
 	void setVertex(VertexHandle vh);
@@ -136,12 +171,20 @@ class FilamentBranch
 	/// \return The execuation status of this function.
 	bool restoreTailEndLocation();
 
-	bool addCap(const CAP& cap);
+	bool addCap(const CAP& c);
 
 	bool removeCap();
 
 	bool removeArp23();
 
+	/// This function severs current filament before its k-th actin
+	/// monomer counted from the pointed end. The first k monomers are
+	/// kept, and the rest are returned as a new filament together with
+	/// the capping protein and the child filaments located on them. The
+	/// child filaments still need to be linked to the new filament once
+	/// it is placed into a filament tree.
+	FilamentBranch sever(size_t k);
+
 	bool isArp23ed() const;
 
 	bool isCapped() const;
@@ -158,7 +201,8 @@ class FilamentBranch
 
 	bool isFilamentEmpty() const;
 
-	Actins& getFilament();
+	/// This function returns a read-only view of the actin monomers.
+	const CompactFilament& getFilament() const;
 
 	size_t length() const;
 
@@ -170,6 +214,10 @@ class FilamentBranch
 
 	void setParentHandle(FilamentBranchHandle ph);
 
+	/// This function returns whether or not current filament is
+	/// linked to a living parent filament.
+	bool hasParent() const;
+
 	size_t getNthChildOfParent();
 
 	void setNthChildOfParent(size_t n);
@@ -180,7 +228,11 @@ class FilamentBranch
 
 	void addChildHandle(FilamentBranchHandle childHandle);
 
-	std::list<size_t>& getChildLocations();
+	/// This function unlinks a child filament together with its
+	/// location, and renumbers the following child filaments.
+	void removeChildHandle(FilamentBranchHandle childHandle);
+
+	std::pmr::list<size_t>& getChildLocations();
 
 	size_t getLastChildLocation() const;
 
@@ -190,7 +242,14 @@ class FilamentBranch
 
 	bool isBranchingAllowed() const;
 
-	ActinConstHandle getBranchingSiteActinConstHandle() const;
+	/// This function returns whether or not the filament is long
+	/// enough to provide an ARP23-binding site.
+	bool hasBranchingSiteActin() const;
+
+	/// This function returns the position of the actin at the
+	/// ARP23-binding site, counted from the pointed end and
+	/// starting from zero.
+	size_t getBranchingSiteActinIndex() const;
 
 	CartesianCoordinate getBranchingSiteActinLocation() const;
 
@@ -202,6 +261,8 @@ class FilamentBranch
 
 	const Orientation& getOrient() const;
 
+	Vector getDirection() const;
+
 	bool getChildBranchingFlag() const;
 
 	void setChildBranchingFlag(bool f);
@@ -216,6 +277,19 @@ class FilamentBranch
 
 	double getInitialLength() const;
 
+	double getNucleotideTime() const;
+
+	void setNucleotideTime(double time);
+
+	/// This function ages the nucleotides of the monomers of this
+	/// filament from the last aging time to a given time.
+	///
+	/// \param time the current simulation time.
+	/// \param hydrolysis_rate the rate constant of ATP hydrolysis.
+	/// \param release_rate the rate constant of Pi release.
+	/// \param engine the random engine dedicated to nucleotide aging.
+	void ageNucleotides(double time, double hydrolysis_rate, double release_rate, std::mt19937& engine);
+
 	simulation::DiscreteEvent_iterators& getReactions();
 
 	void addReaction(simulation::DiscreteEvent_iterator reac);
@@ -223,6 +297,8 @@ class FilamentBranch
 	void removeReaction(simulation::DiscreteEvent_iterator reac);
 
 	FilamentBranch& operator=(const FilamentBranch& fb);
+
+	FilamentBranch& operator=(FilamentBranch&& fb);
 };
 
 inline FilamentBranchHandle filament_branch_handle_null {};
@@ -7,7 +7,6 @@
 #include <FilamentBranch.hpp>
 #include <DiscreteEvent.hpp>
 #include <MotileCell.hpp>
-#include <UniformMolecularDistribution.hpp>
 
 namespace motility
 {
@@ -24,9 +23,11 @@ class FilamentReaction : public simulation::DiscreteEvent
 
 	FilamentBranchHandle filament;
 
-	MotileCell* cell;
+	/// The generational handle of the filament, with which a reaction
+	/// outliving its filament is detected before it is destroyed.
+	FilamentId filament_id;
 
-	UniformMolecularDistribution* ecs;
+	MotileCell* cell;
 
 	/// The filaments affected by the action of this reaction,
 	/// also including itself. MotileCell uses this property to
@@ -40,7 +41,10 @@ class FilamentReaction : public simulation::DiscreteEvent
 
   public:
 
-	FilamentReaction(const std::string& t, FilamentBranchHandle f, MotileCell* c, UniformMolecularDistribution* e);
+	/// The rate and period of a new reaction are initiated unless
+	/// update_flag is false, in which case the caller must update
+	/// them before the reaction is scheduled.
+	FilamentReaction(const std::string& t, FilamentBranchHandle f, MotileCell* c, bool update_flag = true);
 
 	virtual ~FilamentReaction() throw();
 
@@ -48,6 +52,10 @@ class FilamentReaction : public simulation::DiscreteEvent
 
 	FilamentBranchHandle getFilament();
 
+	/// This function returns whether or not the filament of this
+	/// reaction still exists.
+	bool isFilamentValid() const;
+
 	FilamentBranchHandles& getAffectedFilaments();
 
 	void action();
@@ -0,0 +1,155 @@
+#ifndef FILAMENTSTATETABLE_HPP_
+#define FILAMENTSTATETABLE_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <typedefs.hpp>
+#include <Coordinate.hpp>
+#include <GeometryPrecision.hpp>
+
+namespace motility
+{
+
+/// The environment sampled at the tail end of a filament, which is
+/// refreshed at most once after each move of the tail end.
+struct EnvironmentSample
+{
+	/// Whether or not the sample is taken since the tail end last
+	/// moved.
+	bool valid;
+
+	/// Whether the tail end lies in the extracellular signaling region.
+	bool in_signal;
+
+	/// The densities of the uniform distributions of G-actin, ARP23,
+	/// CP and ADF at the tail end.
+	double actin, arp23, cap, adf;
+};
+
+/// The hot state of a filament branch, i.e. the data read by
+/// almost every rate evaluation and statistics loop. The geometry is
+/// stored in the precision given by a PrecisionPolicy.
+template<typename Precision>
+struct BasicFilamentState
+{
+	typedef typename Precision::storage_type storage_type;
+
+	typedef typename Precision::stored_vector stored_vector;
+
+	/// The cached location of the tail (barbed) end.
+	stored_vector tail_end_location;
+
+	/// The cached location of the head (pointed) end.
+	stored_vector head_end_location;
+
+	/// The unit vector of the orientation of the filament.
+	stored_vector direction;
+
+	/// The diameter of the molecule at the tail end.
+	storage_type tail_end_diameter;
+
+	/// The corresponding vertex on cell membrane surface.
+	VertexHandle vertex;
+
+	bool capped;
+
+	/// The environment of the tail end.
+	EnvironmentSample environment;
+
+	/// Whether this entry is held by a filament branch.
+	bool active;
+
+	/// The number of times this entry has been released.
+	size_t generation;
+
+	/// The epoch of the last FilamentSet containing this filament.
+	size_t mark;
+};
+
+typedef BasicFilamentState<GeometryPrecision> FilamentState;
+
+/// FilamentId is a generational handle of a filament. It stays
+/// comparable and checkable after the filament is destroyed, when
+/// the generation of its entry no longer matches.
+struct FilamentId
+{
+	size_t index;
+
+	size_t generation;
+
+	bool operator==(const FilamentId& fid) const { return (index == fid.index && generation == fid.generation); }
+
+	bool operator!=(const FilamentId& fid) const { return !(*this == fid); }
+};
+
+/// FilamentStateTable class stores the hot state of all filament
+/// branches in a dense array indexed by filament id.
+///
+/// Each FilamentBranch acquires an id when it is constructed and
+/// releases it when it is destroyed. The released ids are reused,
+/// so the array stays as dense as the number of living filaments.
+/// The generation of an entry is increased whenever it is released,
+/// such that the handles of destroyed filaments are detected.
+/// The loops over all filaments stream through this array instead
+/// of chasing the list nodes of filament trees, whose remaining
+/// topological and bookkeeping data are rarely touched.
+class FilamentStateTable
+{
+  public:
+
+	class Table
+	{
+		std::vector<FilamentState> states;
+
+		std::vector<size_t> free_ids;
+
+	  public:
+
+		/// This function acquires an id for a new filament.
+		size_t acquire();
+
+		/// This function releases the id of a destroyed filament.
+		void release(size_t id);
+
+		/// This function returns the number of entries, including
+		/// the inactive ones.
+		size_t size() const;
+
+		bool isActive(size_t id) const;
+
+		/// This function returns the generational handle of the
+		/// filament currently holding an id.
+		FilamentId getFilamentId(size_t id) const;
+
+		/// This function checks in constant time whether or not a
+		/// generational handle still refers to a living filament.
+		bool isValid(const FilamentId& fid) const;
+
+		FilamentState& operator[](size_t id);
+
+		const FilamentState& operator[](size_t id) const;
+	};
+
+  private:
+
+	Table table;
+
+	FilamentStateTable();
+
+	virtual ~FilamentStateTable();
+
+  public:
+
+	static Table& instance();
+
+};
+
+/// The id held by no filament, e.g. by a moved filament.
+inline constexpr size_t filament_id_null = static_cast<size_t>(-1);
+
+/// The generational handle which never refers to a filament.
+inline constexpr FilamentId filament_handle_null {filament_id_null, 0};
+
+}
+
+#endif /*FILAMENTSTATETABLE_HPP_*/
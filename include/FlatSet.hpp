@@ -0,0 +1,164 @@
+#ifndef FLATSET_HPP_
+#define FLATSET_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include <typedefs.hpp>
+#include <FilamentStateTable.hpp>
+#include <VertexEdgeFacet.hpp>
+#include <FilamentBranch.hpp>
+
+namespace motility
+{
+
+/// FlatSetMark gives access to the membership mark stored on the
+/// element referred to by a handle. It is specialized for each
+/// handle type held by a FlatSet.
+template<typename T>
+struct FlatSetMark;
+
+template<>
+struct FlatSetMark<VertexHandle>
+{
+	static size_t get(const VertexHandle& vh) { return vh->getMark(); }
+
+	static void set(const VertexHandle& vh, size_t mark) { vh->setMark(mark); }
+};
+
+template<>
+struct FlatSetMark<FilamentBranchHandle>
+{
+	static size_t get(const FilamentBranchHandle& fbh) { return FilamentStateTable::instance()[fbh->getId()].mark; }
+
+	static void set(const FilamentBranchHandle& fbh, size_t mark) { FilamentStateTable::instance()[fbh->getId()].mark = mark; }
+};
+
+/// FlatSet class is a set of handles kept in insertion order in
+/// contiguous storage.
+///
+/// Instead of searching its storage, the set stamps every inserted
+/// element with the epoch of the set, a number never used by any
+/// earlier set of the same type, so insertion, removal and lookup
+/// take constant time apart from the erasure from the storage. As
+/// an element holds a single mark, at most one set of each type may
+/// exist at a time, which is checked in debug builds. The storage is
+/// usually drawn from the scratch arena of the current step.
+template<typename T>
+class FlatSet
+{
+	typedef std::pmr::vector<T> Storage;
+
+	/// The epoch of the latest set of this type.
+	inline static size_t last_epoch = 0;
+
+	/// Whether a set of this type exists.
+	inline static bool live = false;
+
+	Storage elements;
+
+	size_t epoch;
+
+  public:
+
+	typedef typename Storage::const_iterator const_iterator;
+
+	explicit FlatSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : elements(resource)
+	{
+		assert(!live);
+		live = true;
+		epoch = ++last_epoch;
+	}
+
+	template<typename InputIterator>
+	FlatSet(InputIterator first, InputIterator last, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : FlatSet(resource)
+	{
+		insert(first, last);
+	}
+
+	FlatSet(const FlatSet&) = delete;
+
+	FlatSet& operator=(const FlatSet&) = delete;
+
+	~FlatSet()
+	{
+		live = false;
+	}
+
+	bool contains(const T& x) const
+	{
+		return (FlatSetMark<T>::get(x) == epoch);
+	}
+
+	/// This function appends an element unless it is contained, and
+	/// returns whether it is appended.
+	bool insert(const T& x)
+	{
+		if(contains(x)) return false;
+		FlatSetMark<T>::set(x, epoch);
+		elements.push_back(x);
+		return true;
+	}
+
+	template<typename InputIterator>
+	void insert(InputIterator first, InputIterator last)
+	{
+		for(; first != last; ++first) insert(*first);
+	}
+
+	/// This function removes an element while the order of the
+	/// remaining ones is kept, and returns whether it is removed.
+	bool erase(const T& x)
+	{
+		if(!contains(x)) return false;
+		FlatSetMark<T>::set(x, 0);
+		for(typename Storage::iterator it = elements.begin(); it != elements.end(); ++it)
+		{
+			if(*it == x)
+			{
+				elements.erase(it);
+				break;
+			}
+		}
+		return true;
+	}
+
+	void reserve(size_t n)
+	{
+		elements.reserve(n);
+	}
+
+	size_t size() const
+	{
+		return elements.size();
+	}
+
+	bool empty() const
+	{
+		return elements.empty();
+	}
+
+	const T* data() const
+	{
+		return elements.data();
+	}
+
+	const_iterator begin() const
+	{
+		return elements.begin();
+	}
+
+	const_iterator end() const
+	{
+		return elements.end();
+	}
+};
+
+typedef FlatSet<VertexHandle> VertexSet;
+
+typedef FlatSet<FilamentBranchHandle> FilamentSet;
+
+}
+
+#endif /*FLATSET_HPP_*/
@@ -0,0 +1,67 @@
+#ifndef GEOMETRYPRECISION_HPP_
+#define GEOMETRYPRECISION_HPP_
+
+#include <Vec3.hpp>
+#include <Coordinate.hpp>
+
+namespace motility
+{
+
+/// PrecisionPolicy struct defines the precision in which the cached
+/// geometry, i.e. the filament tips and directions in FilamentStateTable
+/// and the areas of membrane facets, is stored, and the precision in which
+/// it is computed and accumulated.
+///
+/// The geometry is always loaded into the accumulation type before any
+/// arithmetic, so the sums over all filaments or facets, e.g. the area of
+/// cell membrane, and the simulation time are kept in double precision,
+/// while a narrower storage type halves the memory streamed by the loops
+/// over the dense arrays and doubles the number of SIMD lanes.
+template<typename Storage, typename Accumulation>
+struct PrecisionPolicy
+{
+	typedef Storage storage_type;
+
+	typedef Accumulation accumulation_type;
+
+	typedef Vec3<Storage> stored_vector;
+
+	typedef Vec3<Accumulation> accumulated_vector;
+
+	static constexpr stored_vector store(const accumulated_vector& v)
+	{
+		return stored_vector(v);
+	}
+
+	static stored_vector store(const CartesianCoordinate& c)
+	{
+		return stored_vector(accumulated_vector(c.x, c.y, c.z));
+	}
+
+	static constexpr accumulated_vector load(const stored_vector& v)
+	{
+		return accumulated_vector(v);
+	}
+
+	static CartesianCoordinate loadCoordinate(const stored_vector& v)
+	{
+		return CartesianCoordinate(v.x, v.y, v.z);
+	}
+};
+
+typedef PrecisionPolicy<double, double> DoublePrecision;
+
+typedef PrecisionPolicy<float, double> SinglePrecision;
+
+/// The build option SINGLE_PRECISION_GEOMETRY selects the storage in
+/// single precision. Otherwise the geometry is stored in double precision
+/// and the results are unchanged.
+#ifdef SINGLE_PRECISION_GEOMETRY
+typedef SinglePrecision GeometryPrecision;
+#else
+typedef DoublePrecision GeometryPrecision;
+#endif
+
+}
+
+#endif /*GEOMETRYPRECISION_HPP_*/
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <Coordinate.hpp>
+#include <Vec3.hpp>
 #include <Vector.hpp>
 
 namespace motility
@@ -14,7 +15,7 @@ class Line
 	/// and an ending point.
 	CartesianCoordinate begin, end;
 
-	Vector vector;
+	Vec3d vector;
 
   public:
 
@@ -28,6 +29,8 @@ class Line
 
 	Line(const CartesianCoordinate& bp, const Vector& v);
 
+	Line(const CartesianCoordinate& bp, const Vec3d& v);
+
 	const CartesianCoordinate& getBegin() const;
 
 	const CartesianCoordinate& getEnd() const;
@@ -48,16 +51,13 @@ class Line
 	/// When 'param' is 'false', the first argument is used
 	/// as the distance from any location on this line to
 	/// the beginning point.
-	CartesianCoordinate getLocation(double r, bool param = true);
+	CartesianCoordinate getLocation(double r, bool param = true) const;
 
-	/// Since some member functions of Vector can modify its
-	/// member data, this function must return a non-const
-	/// reference.
-	Vector& getVector();
+	const Vec3d& getVector() const;
 
-	double length();
+	double length() const;
 
-	Orientation& getOrient();
+	Orientation getOrient() const;
 
 	void setBegin(const CartesianCoordinate& bp);
 
@@ -0,0 +1,32 @@
+#ifndef LINEARGRADIENTMOLECULARDISTRIBUTIONFUNCTION_HPP_
+#define LINEARGRADIENTMOLECULARDISTRIBUTIONFUNCTION_HPP_
+
+#include <MolecularDistributionFunction.hpp>
+
+namespace motility
+{
+
+/// LinearGradientMolecularDistributionFunction class describes molecular
+/// density changing linearly along the x axis.
+///
+/// The density equals the given value at the origin and changes by the
+/// given fraction of this value per unit length, and it is clamped at
+/// zero where the gradient would make it negative.
+class LinearGradientMolecularDistributionFunction : public MolecularDistributionFunction
+{
+  private:
+
+	double value, origin, gradient;
+
+  public:
+
+	LinearGradientMolecularDistributionFunction(double v, double o, double g);
+
+	virtual ~LinearGradientMolecularDistributionFunction();
+
+	double operator()(const CartesianCoordinate& loc) const;
+};
+
+}
+
+#endif /*LINEARGRADIENTMOLECULARDISTRIBUTIONFUNCTION_HPP_*/
@@ -0,0 +1,75 @@
+#ifndef MEMORYARENA_HPP_
+#define MEMORYARENA_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace simulation
+{
+
+/// MemoryArena class provides the memory resources from which the
+/// list-based containers of the simulation are allocated.
+///
+/// The model resource is a pool of fixed-size blocks shared by all
+/// long-lived containers, i.e. molecules, filaments, filament trees,
+/// vertices, edges, facets, events and the lists of their handles.
+/// It is installed as the default memory resource at the start of a
+/// simulation, so every container which is not given a resource
+/// explicitly draws from it. The pool is synchronized because the
+/// rates of reactions may be evaluated in parallel.
+///
+/// The scratch resource is a monotonic arena for the temporary lists
+/// built while a single event is executed. It is released as a whole
+/// after each step of the simulator, so no temporary list may outlive
+/// the step in which it is created. It is not synchronized and must
+/// only be used by the thread driving the simulator.
+class MemoryArena
+{
+  public:
+
+	class Resources
+	{
+		/// The initial buffer of the scratch arena, which is large
+		/// enough for the temporary lists of a typical step.
+		alignas(std::max_align_t) std::byte scratch_buffer[1 << 16];
+
+		std::pmr::synchronized_pool_resource model_pool;
+
+		std::pmr::monotonic_buffer_resource scratch_arena;
+
+	  public:
+
+		Resources();
+
+		~Resources();
+
+		std::pmr::memory_resource* model();
+
+		std::pmr::memory_resource* scratch();
+
+		/// This function installs the model resource as the default
+		/// memory resource.
+		void install();
+
+		/// This function releases all temporary lists of the scratch
+		/// arena at once.
+		void releaseScratch();
+	};
+
+  private:
+
+	Resources resources;
+
+	MemoryArena();
+
+	virtual ~MemoryArena();
+
+  public:
+
+	static Resources& instance();
+
+};
+
+}
+
+#endif /*MEMORYARENA_HPP_*/
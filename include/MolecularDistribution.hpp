@@ -1,6 +1,7 @@
 #ifndef MOLECULARDISTRIBUTION_HPP_
 #define MOLECULARDISTRIBUTION_HPP_
 
+#include <cstddef>
 #include <Coordinate.hpp>
 #include <SpatialBoundary.hpp>
 
@@ -14,28 +15,47 @@ namespace motility
 /// discrete, continuous, or combination of them.
 class MolecularDistribution
 {
+  public:
+
+	/// The kinds of the final molecular distributions, with which the
+	/// density of a distribution is sampled without a virtual call.
+	enum Kind { UNIFORM = 0, NON_UNIFORM, SUBSTRATE_PATTERN, OTHER };
+
   protected:
 
 	/// The boundary of molecular distribution.
 	SpatialBoundary boundary;
 
+	Kind kind;
+
   protected:
 
 	/// Protected MolecularDistribution constructor function.
 	///
 	/// \param bound the spatial boundary.
-	MolecularDistribution(const SpatialBoundary& bound);
+	/// \param k the kind of the derived distribution.
+	MolecularDistribution(const SpatialBoundary& bound, Kind k = OTHER);
 
 	/// Protected MolecularDistribution destructor function.
 	virtual ~MolecularDistribution();
 
   public:
 
+	Kind getKind() const;
+
 	/// This function returns the molecular density at specified location.
 	///
 	/// \param loc the spatial location.
 	/// \return molecular density.
 	virtual double getDensity(const CartesianCoordinate& loc) = 0;
+
+	/// This function returns the molecular densities at a batch of
+	/// locations, e.g. the tail ends of all filaments.
+	///
+	/// \param locs the spatial locations.
+	/// \param n the number of locations.
+	/// \param dens the molecular densities, one for each location.
+	virtual void getDensities(const CartesianCoordinate* locs, size_t n, double* dens);
 };
 
 }
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <memory_resource>
 #include <Coordinate.hpp>
 
 namespace motility
@@ -39,8 +40,16 @@ class Molecule
 
 	Molecule(int s = 0, double diam = 0.01, const CartesianCoordinate& loc = CartesianCoordinate(), bool mob = true, const char* t = "generic Molecule");
 
+	Molecule(const Molecule& m) = default;
+
+	Molecule(Molecule&& m) = default;
+
 	virtual ~Molecule();
 
+	Molecule& operator=(const Molecule& m) = default;
+
+	Molecule& operator=(Molecule&& m) = default;
+
 	std::string getType() const;
 
 	void setType(const char* t);
@@ -76,7 +85,7 @@ class Molecule
 	friend std::ostream& operator<<(std::ostream& os, const Molecule& m);
 };
 
-typedef std::list<Molecule> Molecules;
+typedef std::pmr::list<Molecule> Molecules;
 typedef Molecules::iterator MoleculeHandle;
 typedef Molecules::const_iterator MoleculeConstHandle;
 
@@ -2,12 +2,17 @@
 #define MOTILECELL_HPP_
 
 #include <map>
+#include <random>
+#include <vector>
 #include <typedefs.hpp>
 #include <DiscreteEventSimulator.hpp>
 #include <BranchTree.hpp>
 #include <FilamentBranch.hpp>
 #include <UniformMolecularDistribution.hpp>
+#include <ReactionDiffusionField.hpp>
+#include <ReactionNetwork.hpp>
 #include <SurfaceTopology.hpp>
+#include <TrajectoryFile.hpp>
 #include <VertexEdgeFacet.hpp>
 
 namespace motility
@@ -24,7 +29,7 @@ class MotileCell : public simulation::DiscreteEventSimulator
   private:
 
 	// The pointer to extracellular signal distribution.
-	UniformMolecularDistribution* ecs_dist;
+	MolecularDistribution* ecs_dist;
 
 	/// The actin cytoskeleton of motile cell.
 	BranchTrees filament_network;
@@ -42,12 +47,86 @@ class MotileCell : public simulation::DiscreteEventSimulator
 
 	UniformMolecularDistribution* adf_dist;
 
+	/// The reaction-diffusion field of cytosolic G-actin, Arp23 and
+	/// CP, which replaces their uniform distributions if it is not
+	/// null.
+	ReactionDiffusionField* cytosol_field;
+
+	/// The time moment of the latest update of the cytosolic field.
+	double last_field_time;
+
+	/// The simulation time between two updates of the cytosolic field.
+	double field_update_interval;
+
+	/// The well-mixed reaction network of the cytosol and membrane
+	/// compartments, which replaces the uniform distributions of
+	/// G-actin and Arp23 if it is not null and the reaction-diffusion
+	/// field is null.
+	ReactionNetwork* network;
+
+	/// The reactions of the network, i.e. one reaction per channel in
+	/// the exact method, or a single leaping reaction.
+	std::vector<FilamentReaction_iterator> network_reaction_ptrs;
+
+	/// The network species of the cytosolic species, or species_null
+	/// for those not in the network.
+	size_t network_species[ReactionDiffusionField::SPECIES_NUM];
+
+	/// The network species of free ADF and of the ADF-bound G-actin
+	/// released by shrinking.
+	size_t network_adf, network_adp_adf;
+
+	/// The network species of the ADP-actin and the free Arp23 released
+	/// by removed filaments.
+	size_t network_adp, network_arp23;
+
+	/// The network species of the inactive WASP released by branching.
+	size_t network_wasp;
+
+	/// The stamps marking the exact network reactions already modified
+	/// by the current reaction, and the stamp of the current reaction.
+	std::vector<size_t> network_channel_stamps;
+
+	size_t network_stamp;
+
+	/// The time moment at which the filament reactions are latest
+	/// re-evaluated with the network concentrations.
+	double last_network_time;
+
+	/// The simulation time between two re-evaluations of the filament
+	/// reactions with the network concentrations.
+	double network_update_interval;
+
+	/// The random engine of tau-leaping.
+	std::mt19937 network_engine;
+
 	/// The the name and the directory of geometry files.
 	std::string data_dir, cell_geom_filename, cell_geom_filename_ext;
 
 	/// The pointer to the calculator of cell statistics.
 	CellStatisticsCalculator* cell_statistics_calculator;
 
+	/// The writer of the binary trajectory file, which replaces the
+	/// OFF-format geometry files if it is not null.
+	TrajectoryWriter* trajectory_writer;
+
+	/// The frame of cell geometry written into the binary trajectory file
+	/// or an OFF-format file, kept between records to avoid reallocation.
+	TrajectoryFrame trajectory_frame;
+
+	/// The random engine of nucleotide aging, which is kept apart
+	/// from the random generator of reaction events.
+	std::mt19937 nucleotide_engine;
+
+	/// The rate constants of ATP hydrolysis and Pi release of the
+	/// polymerized actin monomers.
+	double hydrolysis_rate_const, release_rate_const;
+
+	/// The reactions of the filaments removed by the action of the
+	/// current reaction, which are destroyed when the interactions of
+	/// the current reaction are updated.
+	FilamentReaction_iterators removed_reactions;
+
   private:
 
 	FilamentBranch makeNewFilament(double rou, double theta, double phi);
@@ -58,6 +137,43 @@ class MotileCell : public simulation::DiscreteEventSimulator
 
 	void associateNewFilamentReaction(FilamentReaction_iterator growing_reaction_ptr, FilamentReaction_iterator branching_reaction_ptr, FilamentReaction_iterator capping_reaction_ptr);
 
+	void associateSeveringReaction(FilamentReaction_iterator severing_reaction_ptr, FilamentReaction_iterator growing_reaction_ptr, FilamentReaction_iterator branching_reaction_ptr, FilamentReaction_iterator capping_reaction_ptr);
+
+	/// This function adds the reactions of the network and connects
+	/// each exact reaction to the reactions it affects.
+	void initializeNetworkReaction();
+
+	/// This function adds or removes a number of molecules of a network
+	/// species, unless there is no network or no such species.
+	void exchangeNetworkMolecules(size_t species, long n);
+
+	/// This function adds the exact network reactions depending on a
+	/// network species to the modified reactions of a reaction, unless
+	/// they have been added while connecting this reaction.
+	void modifyNetworkReactions(FilamentReaction_iterator reaction_ptr, size_t species);
+
+	/// This function returns whether or not the reaction network, if
+	/// it provides ADF to filaments, has ADF left.
+	bool isNetworkAdfAvailable() const;
+
+	/// This function returns the molecules of a filament to be removed
+	/// into the reaction-diffusion field or the reaction network.
+	void releaseFilamentMolecules(FilamentBranchHandle branch_handle);
+
+	/// This function returns whether or not ADF is present, in which
+	/// case the shrinking and severing reactions are simulated.
+	bool isAdfPresent() const;
+
+	/// This function schedules the reactions of a filament to be
+	/// removed for destruction.
+	void discardFilamentReactions(FilamentBranchHandle branch_handle);
+
+	/// This function removes a filament from filament network and
+	/// returns its molecules. The subtrees of its child filaments are
+	/// moved into their own filament trees, and the filament tree left
+	/// empty is erased.
+	void removeFilament(FilamentBranchHandle branch_handle);
+
 	void connect(FilamentReaction_iterator reaction_ptr);
 
 	void create(FilamentReaction_iterator reaction_ptr);
@@ -74,19 +190,46 @@ class MotileCell : public simulation::DiscreteEventSimulator
 	/// \return The change of the energy of total energy.
 	double computeEnergyChange(FilamentBranchHandle branch_handle, const std::string& type);
 
+	/// This function ages the nucleotides of all actin filaments up
+	/// to current simulation time.
+	void ageFilamentNetwork();
+
+	/// This function returns the environment of the tail end of a
+	/// filament, sampling it if the tail end has moved since the
+	/// last sample.
+	const EnvironmentSample& getEnvironment(FilamentBranchHandle branch_handle);
+
+	/// This function records a snapshot of cell geometry, either as a
+	/// frame of the binary trajectory file or as an OFF-format file
+	/// whose name ends with a given suffix.
+	void recordCellGeometry(const std::string& suffix);
+
+	/// This function returns the cytosolic concentration of a species
+	/// at the tip of a filament, either from the reaction-diffusion
+	/// field, from the reaction network or from the environment
+	/// sampled from the uniform distribution of the species.
+	double getCytosolicConcentration(ReactionDiffusionField::Species s, FilamentBranchHandle branch_handle);
+
+	/// This function returns the ADF concentration at the tip of a
+	/// filament, either from the reaction network unless the
+	/// reaction-diffusion field is simulated, or from the environment.
+	double getAdfConcentration(FilamentBranchHandle branch_handle);
+
 	/// A set of overriden functions from DiscreteEventSimulator
 
 	void step_record();
 
 	void time_record();
 
+	void integrate();
+
 	void initialize();
 
 	void finalize();
 
   public:
 
-	MotileCell(double max_duration, size_t max_step, double record_time_interval, size_t record_step_interval, UniformMolecularDistribution* ecsd_ptr, const std::string dir, const std::string geom_filename, const std::string geom_filename_ext);
+	MotileCell(double max_duration, size_t max_step, double record_time_interval, size_t record_step_interval, MolecularDistribution* ecsd_ptr, const std::string dir, const std::string geom_filename, const std::string geom_filename_ext);
 
 	virtual ~MotileCell() throw();
 
@@ -110,6 +253,14 @@ class MotileCell : public simulation::DiscreteEventSimulator
 	/// These functions are called by FilamentReaction when
 	/// corresponding reaction gets executed.
 
+	/// This function returns whether or not the tail end of a
+	/// filament lies in the extracellular signaling region. The
+	/// result is cached until the tail end moves.
+	///
+	/// \param branch_handle the handle of a filament.
+	/// \return Whether or not the extracellular signal is sensed.
+	bool isTipInSignal(FilamentBranchHandle branch_handle);
+
 	/// This function calculates the rate of filament growing
 	/// reaction.
 	///
@@ -131,6 +282,21 @@ class MotileCell : public simulation::DiscreteEventSimulator
 	/// \return The rate of filament capping reaction.
 	double computeFilamentCappingRate(FilamentBranchHandle branch_handle);
 
+	/// This function calculates the rate of capped filament
+	/// shrinking reaction.
+	///
+	/// \param branch_handle the handle of a filament.
+	/// \return The rate of capped filament shrinking reaction.
+	double computeFilamentShrinkingRate(FilamentBranchHandle branch_handle);
+
+	/// This function calculates an upper bound of the rate of
+	/// filament severing reaction, aggregated over all monomers of
+	/// the filament which may hold ADP-actin.
+	///
+	/// \param branch_handle the handle of a filament.
+	/// \return The rate of filament severing reaction.
+	double computeFilamentSeveringRate(FilamentBranchHandle branch_handle);
+
 	/// This function updates the attachment status of capped
 	/// filaments.
 	///
@@ -163,6 +329,18 @@ class MotileCell : public simulation::DiscreteEventSimulator
 	/// extracellular fibronectin.
 	/// \return A list of vertices affected by filament capping.
 	VertexHandles capFilament(FilamentBranchHandle branch_handle);
+
+	/// This function executes capped filament shrinking reaction.
+	///
+	/// \param branch_handle the handle of a filament.
+	/// \return A list of vertices affected by filament shrinking.
+	VertexHandles shrinkFilament(FilamentBranchHandle branch_handle);
+
+	/// This function executes filament severing reaction.
+	///
+	/// \param branch_handle the handle of a filament.
+	/// \return A list of vertices affected by filament severing.
+	VertexHandles severFilament(FilamentBranchHandle branch_handle);
 };
 
 }
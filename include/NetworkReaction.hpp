@@ -0,0 +1,60 @@
+#ifndef NETWORKREACTION_HPP_
+#define NETWORKREACTION_HPP_
+
+#include <cstddef>
+#include <random>
+#include <DiscreteEvent.hpp>
+#include <ReactionNetwork.hpp>
+
+namespace motility
+{
+
+/// NetworkReaction class schedules the reactions of a well-mixed
+/// ReactionNetwork alongside the filament reactions.
+///
+/// An exact network reaction stands for a single channel of the network
+/// and occurs at its propensity. A leaping network reaction stands for
+/// the whole network and occurs at the rate of one leap per leap period,
+/// firing all channels over one leap period each time it occurs, such
+/// that the network is advanced over the elapsed time on average.
+class NetworkReaction : public simulation::DiscreteEvent
+{
+  private:
+
+	ReactionNetwork* network;
+
+	/// The channel of an exact network reaction.
+	size_t channel;
+
+	/// The leap period of a leaping network reaction, which is zero
+	/// for an exact network reaction.
+	double leap_period;
+
+	/// The random number engine of the Poisson firings of a leaping
+	/// network reaction.
+	std::mt19937* engine;
+
+  private:
+
+	double compute_rate();
+
+  public:
+
+	/// This constructor creates an exact network reaction of a channel.
+	NetworkReaction(ReactionNetwork* n, size_t c);
+
+	/// This constructor creates a leaping network reaction.
+	NetworkReaction(ReactionNetwork* n, double tau, std::mt19937* e);
+
+	virtual ~NetworkReaction() throw();
+
+	size_t getChannel() const;
+
+	bool isLeaping() const;
+
+	void action();
+};
+
+}
+
+#endif /*NETWORKREACTION_HPP_*/
@@ -0,0 +1,73 @@
+#ifndef NONUNIFORMMOLECULARDISTRIBUTION_HPP_
+#define NONUNIFORMMOLECULARDISTRIBUTION_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <MolecularDistribution.hpp>
+#include <MolecularDistributionFunction.hpp>
+
+namespace motility
+{
+
+/// NonUniformMolecularDistribution class describes molecular distribution
+/// sampled on a regular grid.
+///
+/// The molecular densities are evaluated by a MolecularDistributionFunction
+/// on all grid points of the spatial region between boundaries once, when
+/// the distribution is constructed, and the density at any location is
+/// trilinearly interpolated from the eight surrounding grid points.
+///
+/// The grid points are stored brick by brick, where each brick holds a
+/// cube of 4x4x4 neighboring grid points in a contiguous block of memory,
+/// such that an interpolation mostly touches a single cache-resident brick
+/// instead of four distant rows of the grid.
+class NonUniformMolecularDistribution final : public MolecularDistribution
+{
+  private:
+
+	/// The number of grid points along each edge of a brick.
+	static constexpr size_t brick_size = 4;
+
+	/// The numbers of grid points along each axis.
+	size_t nx, ny, nz;
+
+	/// The numbers of bricks along each axis.
+	size_t bx, by, bz;
+
+	/// The location of the first grid point, i.e. the lower corner of
+	/// the boundary.
+	double x0, y0, z0;
+
+	/// The reciprocal grid spacings along each axis, which are zero for
+	/// an axis with a single grid point.
+	double inv_hx, inv_hy, inv_hz;
+
+	std::vector<double> densities;
+
+  private:
+
+	/// This function returns the position of a grid point in the bricked
+	/// storage.
+	size_t getIndex(size_t i, size_t j, size_t k) const;
+
+	/// This function interpolates the density at a location inside the
+	/// boundary.
+	double interpolate(double x, double y, double z) const;
+
+  public:
+
+	/// NonUniformMolecularDistribution constructor function.
+	///
+	/// \param bound the spatial boundary.
+	/// \param func the molecular distribution function evaluated on grid points.
+	/// \param spacing the maximum grid spacing.
+	NonUniformMolecularDistribution(const SpatialBoundary& bound, const MolecularDistributionFunction& func, double spacing);
+
+	double getDensity(const CartesianCoordinate& loc);
+
+	void getDensities(const CartesianCoordinate* locs, size_t n, double* dens);
+};
+
+}
+
+#endif /*NONUNIFORMMOLECULARDISTRIBUTION_HPP_*/
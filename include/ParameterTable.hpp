@@ -22,6 +22,12 @@ class ParameterTable
 
 	static std::map<std::string, std::string>& instance();
 
+	/// This function looks up the value of a parameter without
+	/// modifying the table, so that the parameters can be read
+	/// concurrently once the table is initialized. A parameter
+	/// missing from the parameter file is reported as an error.
+	static const std::string& lookup(const std::string& name);
+
 };
 
 }
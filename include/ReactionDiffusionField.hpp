@@ -0,0 +1,118 @@
+#ifndef REACTIONDIFFUSIONFIELD_HPP_
+#define REACTIONDIFFUSIONFIELD_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <Coordinate.hpp>
+#include <SpatialBoundary.hpp>
+#include <FilamentBranch.hpp>
+
+namespace motility
+{
+
+/// ReactionDiffusionField class describes the cytosolic concentrations
+/// of G-actin, ARP23 and CAP on a regular grid of voxels covering the
+/// spatial boundary.
+///
+/// The field is coupled to the filament reactions by operator splitting.
+/// Between two updates of the field, the reactions consume or release
+/// molecules in the voxels at filament tips, while the concentrations
+/// seen by the reaction rates are frozen. Each update then diffuses all
+/// species over the elapsed period with an explicit finite-difference
+/// scheme and zero-flux boundaries, sub-cycled within the stability
+/// limit of the scheme.
+///
+/// The concentrations at the tip of each filament are sampled at most
+/// once between two updates and cached under the id of the filament,
+/// so the rate evaluation of a reaction only pays a table lookup.
+class ReactionDiffusionField
+{
+  public:
+
+	/// The diffusing species.
+	enum Species { ACTIN = 0, ARP23, CAP, SPECIES_NUM };
+
+  private:
+
+	/// The concentrations sampled at the tip of a filament.
+	struct TipSample
+	{
+		/// The update of the field at which the sample is taken.
+		size_t stamp;
+
+		/// The generation of the filament id at which the sample
+		/// is taken.
+		size_t generation;
+
+		double concs[SPECIES_NUM];
+	};
+
+	SpatialBoundary boundary;
+
+	/// The numbers of voxels along each axis.
+	size_t nx, ny, nz;
+
+	/// The voxel sizes along each axis.
+	double hx, hy, hz;
+
+	double diffusion_coef;
+
+	/// The concentration of a single molecule in a voxel, in uM.
+	double molecule_conc;
+
+	/// The concentrations of each species, in uM, stored with x
+	/// varying fastest.
+	std::vector<double> concs[SPECIES_NUM];
+
+	/// The concentrations of the next sub-cycle.
+	std::vector<double> next_concs;
+
+	std::vector<TipSample> tip_samples;
+
+	/// The number of updates of the field.
+	size_t stamp;
+
+  private:
+
+	size_t getVoxelIndex(const CartesianCoordinate& loc) const;
+
+	/// This function diffuses the concentrations of a species over one
+	/// time step within the stability limit.
+	void diffuse(std::vector<double>& conc, double dt);
+
+  public:
+
+	/// ReactionDiffusionField constructor function.
+	///
+	/// \param bound the spatial boundary.
+	/// \param spacing the maximum voxel size.
+	/// \param coef the diffusion coefficient of all species, in um^2/s.
+	/// \param initial_concs the uniform initial concentrations of all
+	/// species, in uM.
+	ReactionDiffusionField(const SpatialBoundary& bound, double spacing, double coef, const double* initial_concs);
+
+	/// This function returns the current concentration of a species
+	/// at a location, which is zero outside the boundary and in a voxel
+	/// in deficit.
+	double getConcentration(Species s, const CartesianCoordinate& loc) const;
+
+	/// This function returns the concentration of a species at the tip
+	/// of a filament as of the latest update of the field.
+	double getTipConcentration(Species s, const FilamentBranch& branch);
+
+	/// This function adds a number of molecules of a species into the
+	/// voxel at a location, or removes them if the number is negative.
+	/// A location outside the boundary is assigned to the nearest voxel.
+	/// The molecules removed beyond the content of a voxel are kept as
+	/// a deficit, i.e. a negative concentration, which diffusion refills
+	/// from the neighboring voxels, so that no molecule is lost.
+	void addMolecules(Species s, const CartesianCoordinate& loc, double n);
+
+	/// This function diffuses all species over a period of time and
+	/// invalidates the concentrations cached at filament tips.
+	void advance(double period);
+};
+
+}
+
+#endif /*REACTIONDIFFUSIONFIELD_HPP_*/
@@ -0,0 +1,159 @@
+#ifndef REACTIONNETWORK_HPP_
+#define REACTIONNETWORK_HPP_
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace motility
+{
+
+/// ReactionNetwork class simulates a well-mixed network of mass-action
+/// reactions among molecular species counted as integers.
+///
+/// The network is compiled from the reaction types of given compartments
+/// in ReactionTypeTable. Every species is assigned an index, and every
+/// reversible reaction type becomes one or two irreversible channels, for
+/// its forward and backward directions with nonzero rate constants. The
+/// reactants and the stoichiometric changes of all channels are stored in
+/// flat arrays, along with a dependency graph listing the channels whose
+/// propensities depend on each species, so that firing a channel neither
+/// allocates memory nor looks up a name.
+///
+/// The network is simulated either exactly, with one discrete event per
+/// channel, or by tau-leaping, where all channels fire a Poisson number
+/// of times in each leap.
+///
+/// If the build option COMPILED_REACTION_NETWORK is on, the propensities
+/// and the updates are evaluated by the kernels generated from the
+/// reaction file at build time, provided that the network compiled at
+/// run time is the same. Otherwise the flat arrays are interpreted.
+class ReactionNetwork
+{
+	/// The number of molecules per um^3 at the concentration of 1 uM.
+	static constexpr double molecules_per_um3_uM = 602.214;
+
+	/// An irreversible reaction channel. The reactants and the changes
+	/// of a channel are the ranges [reactant_begin, reactant_end) and
+	/// [change_begin, change_end) of the flat arrays.
+	struct Channel
+	{
+		size_t reactant_begin, reactant_end;
+
+		size_t change_begin, change_end;
+	};
+
+	std::vector<std::string> species_names;
+
+	std::vector<long> counts;
+
+	std::vector<Channel> channels;
+
+	/// The stochastic rate constants of all channels, i.e. the rate
+	/// constants in molecule counts.
+	std::vector<double> rate_consts;
+
+	/// The species of the reactants of all channels, sorted within
+	/// each channel such that repeated reactants are adjacent.
+	std::vector<size_t> reactant_species;
+
+	std::vector<size_t> change_species;
+
+	std::vector<long> change_amounts;
+
+	/// The channels depending on species i are the range
+	/// [dependent_offsets[i], dependent_offsets[i+1]) of dependents.
+	std::vector<size_t> dependent_offsets;
+
+	std::vector<size_t> dependents;
+
+	/// The volume of the compartment in um^3.
+	double volume;
+
+	/// Whether or not the generated kernels match this network.
+	bool compiled;
+
+	/// The propensities and the Poisson firings of all channels in a
+	/// leap, kept between leaps to avoid reallocation.
+	std::vector<double> leap_propensities;
+
+	std::vector<long> leap_firings;
+
+  private:
+
+	size_t addSpecies(const std::string& name);
+
+	/// This function appends a channel converting the given reactants
+	/// into the given products with a rate constant in uM and s.
+	void addChannel(const std::vector<size_t>& reactants, const std::vector<size_t>& products, double rate_const);
+
+	/// This function computes the propensities of all channels.
+	void computePropensities(double* a) const;
+
+	/// This function fires every channel c by firings[c] times without
+	/// keeping the counts non-negative.
+	void fire(const long* firings);
+
+  public:
+
+	/// The index returned for a species not in the network.
+	static constexpr size_t species_null = static_cast<size_t>(-1);
+
+	/// ReactionNetwork constructor function.
+	///
+	/// \param compartments the sections of the reaction file whose
+	/// reaction types are compiled into the network.
+	/// \param vol the volume of the compartment in um^3.
+	ReactionNetwork(const std::vector<std::string>& compartments, double vol);
+
+	size_t getSpeciesNumber() const;
+
+	size_t getChannelNumber() const;
+
+	/// This function returns whether or not the network is evaluated
+	/// by the kernels generated at build time.
+	bool isCompiled() const;
+
+	/// This function returns the index of a species, or species_null
+	/// if the species is not in the network.
+	size_t getSpeciesIndex(const std::string& name) const;
+
+	const std::string& getSpeciesName(size_t i) const;
+
+	long getCount(size_t i) const;
+
+	double getConcentration(size_t i) const;
+
+	void setConcentration(size_t i, double conc);
+
+	/// This function adds a number of molecules of a species, or removes
+	/// them if the number is negative, keeping the count non-negative.
+	void addMolecules(size_t i, long n);
+
+	/// This function returns the propensity of a channel at the current
+	/// molecule counts.
+	double getPropensity(size_t c) const;
+
+	/// This function fires a channel once.
+	void fire(size_t c);
+
+	/// This function fires all channels over a period of time by
+	/// tau-leaping. The counts which would become negative in a too
+	/// long leap are truncated at zero.
+	void leap(double tau, std::mt19937& engine);
+
+	/// These functions return the channels whose propensities depend
+	/// on species i.
+	const size_t* beginDependents(size_t i) const;
+
+	const size_t* endDependents(size_t i) const;
+
+	/// This function collects the channels whose propensities change
+	/// when channel c fires, excluding duplicates.
+	void getAffectedChannels(size_t c, std::vector<size_t>& affected) const;
+};
+
+}
+
+#endif /*REACTIONNETWORK_HPP_*/
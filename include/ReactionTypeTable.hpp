@@ -18,6 +18,10 @@ class ReactionTypeTable
 		std::list<std::string> reactants, products;
 		double forward_const, backward_const;
 
+		/// The section of the reaction file in which the reaction
+		/// type is defined, e.g. "cytosol" or "membrane".
+		std::string compartment;
+
 		ReactionType();
 		void clear();
 	};
@@ -34,6 +38,12 @@ class ReactionTypeTable
 
 	static Table& instance();
 
+	/// This function looks up a reaction type without modifying the
+	/// table, so that the reaction types can be read concurrently
+	/// once the table is initialized. A reaction type missing from
+	/// the reaction file is reported as an error.
+	static const ReactionType& lookup(const std::string& name);
+
 };
 
 }
@@ -0,0 +1,82 @@
+#ifndef SUBSTRATEPATTERNDISTRIBUTION_HPP_
+#define SUBSTRATEPATTERNDISTRIBUTION_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <MolecularDistribution.hpp>
+
+namespace motility
+{
+
+/// SubstratePatternDistribution class describes molecular distribution
+/// printed on a substrate by a 2D pattern.
+///
+/// The pattern is an 8-bit or 16-bit binary PGM image, or a raw 8-bit
+/// bitmap of given size, which is memory-mapped when it is loaded. The
+/// image is stretched over the x-y extent of the spatial boundary with
+/// its first row at the maximum y, and the density at a location inside
+/// the boundary is that of the nearest pixel scaled by the gray level,
+/// such that the z extent of the boundary defines the slab above the
+/// substrate in which the pattern is sensed.
+///
+/// The gray levels are stored tile by tile, where each tile holds a
+/// square of 16x16 neighboring pixels in a contiguous block of memory,
+/// and the densities of all gray levels are tabulated, so a lookup only
+/// costs a few integer operations and two loads.
+class SubstratePatternDistribution final : public MolecularDistribution
+{
+  private:
+
+	/// The number of pixels along each edge of a tile.
+	static constexpr size_t tile_size = 16;
+
+	/// The numbers of pixels along each axis.
+	size_t width, height;
+
+	/// The number of tiles along the x axis.
+	size_t tiles_x;
+
+	/// The lower corner of the boundary.
+	double x0, y0;
+
+	/// The reciprocal pixel sizes along each axis.
+	double inv_px, inv_py;
+
+	/// The gray levels of all pixels in the tiled storage.
+	std::vector<unsigned char> levels;
+
+	/// The density of each gray level.
+	double level_densities[256];
+
+  private:
+
+	/// This function reads the gray levels from a memory-mapped file.
+	void load(const std::string& filename, size_t raw_width, size_t raw_height);
+
+	/// This function returns the position of a pixel in the tiled storage.
+	size_t getIndex(size_t i, size_t j) const;
+
+	/// This function returns the density at a location on the x-y
+	/// extent of the boundary.
+	double lookup(double x, double y) const;
+
+  public:
+
+	/// SubstratePatternDistribution constructor function.
+	///
+	/// \param bound the spatial boundary.
+	/// \param filename the file of the pattern.
+	/// \param dens the molecular density of the brightest gray level.
+	/// \param raw_width the width of a raw bitmap, ignored for a PGM image.
+	/// \param raw_height the height of a raw bitmap, ignored for a PGM image.
+	SubstratePatternDistribution(const SpatialBoundary& bound, const std::string& filename, double dens, size_t raw_width = 0, size_t raw_height = 0);
+
+	double getDensity(const CartesianCoordinate& loc);
+
+	void getDensities(const CartesianCoordinate* locs, size_t n, double* dens);
+};
+
+}
+
+#endif /*SUBSTRATEPATTERNDISTRIBUTION_HPP_*/
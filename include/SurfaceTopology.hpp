@@ -2,10 +2,15 @@
 #define SURFACETOPOLOGY_HPP_
 
 #include <string>
+#include <vector>
+#include <memory_resource>
 #include <typedefs.hpp>
 #include <Coordinate.hpp>
 #include <Line.hpp>
 #include <VertexEdgeFacet.hpp>
+#include <FlatSet.hpp>
+#include <FacetGrid.hpp>
+#include <TrajectoryFile.hpp>
 
 namespace motility
 {
@@ -97,6 +102,13 @@ class SurfaceTopology
 	/// The total surface area of cell membrane.
 	double area;
 
+	/// The spatial index of the facets used by global searches.
+	FacetGrid facet_grid;
+
+	/// Whether or not the whole membrane surface is searched for the
+	/// facet intersecting a filament when the local search fails.
+	bool global_facet_search_flag;
+
   private:
   
 	/// This function inserts a vertex into a facet.
@@ -113,6 +125,12 @@ class SurfaceTopology
 	/// \return No returned value.
 	void updateNeighboringFacets(VertexHandle vertex_handle);
 
+	/// This function builds the facet grid, or rebuilds it if its cell
+	/// size no longer matches the mean edge length of membrane surface.
+	///
+	/// \return No returned value.
+	void refitFacetGrid();
+
   public:
 
 	/// SurfaceTopology constructor function.
@@ -202,7 +220,7 @@ class SurfaceTopology
 	///
 	/// \param vertex_handle the vertex handle of a filament.
 	/// \return The centered directional area of local surface around a filament.
-	Vector computeCenteredDirectionalAreaOfLocalSurface(VertexHandle vertex_handle);
+	Vec3d computeCenteredDirectionalAreaOfLocalSurface(VertexHandle vertex_handle);
 
 
 	/// This function calculates the centered directional local area around a point.
@@ -210,7 +228,7 @@ class SurfaceTopology
 	/// \param v the location of the tail end of a filament.
 	/// \param facet_handle the facet handle which a filament intersects with.
 	/// \return The centered directional area of local surface around a filament.
-	Vector computeCenteredDirectionalAreaOfLocalSurface(CartesianCoordinate v, FacetHandle facet_handle);
+	Vec3d computeCenteredDirectionalAreaOfLocalSurface(CartesianCoordinate v, FacetHandle facet_handle);
 
 	/// This function calculates the integral of surface curvature.
 	///
@@ -250,6 +268,18 @@ class SurfaceTopology
 	/// cell membrane surface.
 	bool addFacet(VertexHandle vh1, VertexHandle vh2, VertexHandle vh3);
 
+	/// This function adds a batch of facets into cell membrane surface at
+	/// one time. The facets are connected exactly as if they were added one
+	/// by one through addFacet, but the eligibility of each facet is not
+	/// checked and the dual edges are found through a hash table, so that
+	/// a large initial surface can be constructed in linear time.
+	///
+	/// \param vertex_table the handles of the vertices referred by facets.
+	/// \param facet_table the vertex indices of the facets, three per facet,
+	/// which must describe a two-manifold surface in the order of addition.
+	/// \return No value is returned.
+	void addFacets(const std::vector<VertexHandle>& vertex_table, const std::vector<size_t>& facet_table);
+
 	/// This function removes a given facet from membrane geometry. 
 	///
 	/// \param fh the handle of a facet on membrane surface.
@@ -262,6 +292,15 @@ class SurfaceTopology
 	/// \return The handles of all affected neighboring vertices.
 	VertexHandles removeVertex(VertexHandle vh);
 
+	/// This function validates the whole membrane surface, i.e. the links
+	/// among its vertices, edges and facets, the links between vertices
+	/// and filaments, and the cached membrane area. It is called by the
+	/// expensive tier of invariant checks after each topological change.
+	///
+	/// \return A boolean status indicating whether or not the membrane
+	/// surface is consistent.
+	bool isConsistent();
+
 	/// This function updates the composite properties of cell membrane.
 	///
 	/// \param vh the handle of a vertex on membrane surface.
@@ -276,7 +315,12 @@ class SurfaceTopology
 	///
 	/// \param vertex_handle the handle of a vertex on membrane surface.
 	/// \return The handles of the closest neighboring vertices.
-	VertexHandles getNeighboringVertexHandles(VertexHandle vertex_handle) const;
+	VertexHandles getNeighboringVertexHandles(VertexHandle vertex_handle, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+	/// This function inserts the closest neighboring vertices around a
+	/// vertex into a set, such that the connection of two vertices is
+	/// checked in constant time.
+	void getNeighboringVertexHandles(VertexHandle vertex_handle, VertexSet& neighboring_vertices) const;
 
 	/// This function returns the closest local facets of a vertex.
 	///
@@ -303,7 +347,7 @@ class SurfaceTopology
 	/// \param t the triangle of the facet that child filament is oriented
 	/// towards.
 	/// \return The orientation of child filament.
-	Orientation computeBranchingOrientation(const CartesianCoordinate& bs, double alpha, const CartesianCoordinate& tip, Triangle& t);
+	Orientation computeBranchingOrientation(const CartesianCoordinate& bs, double alpha, const CartesianCoordinate& tip, const Triangle& t);
 
 	/// This function determins whether a branching reaction is allowed for an actin filament.
 	///
@@ -322,6 +366,14 @@ class SurfaceTopology
 	/// returned.
 	FacetHandle getIntersectingFacetHandle(FilamentBranch& branch, FacetHandle start_facet_handle);
 
+	/// This function searches the whole membrane surface for a facet with which a line segment intersects.
+	///
+	/// \param l the line segment.
+	/// \return The handle of the intersecting facet whose intersection
+	/// is closest to the end of the line segment. If no such facet is
+	/// found, then 0 is returned.
+	FacetHandle getIntersectingFacetHandle(Line& l);
+
 	/// This function calculates the orientation of extracellular signaling
 	/// region which will be used as the perfered branching orientation for
 	/// child filament.
@@ -335,7 +387,14 @@ class SurfaceTopology
 	/// direction and the radial direction.
 	double computeDeviationAngleOfFilamentGrowth(FilamentBranch& branch);
 
-	double computeDeviationAngleOfFilamentGrowth(FilamentBranch& mother_branch, const Orientation& child_branch_orient);
+	/// This function calculates the same angle from the hot state of a
+	/// filament, which is used by the loops over FilamentStateTable.
+	double computeDeviationAngleOfFilamentGrowth(const FilamentState& state);
+
+	/// This function calculates the cosine of the angle between the growing
+	/// direction of a child filament and the radial direction at its
+	/// branching site, which is compared without computing the angle.
+	double computeDeviationCosineOfFilamentGrowth(FilamentBranch& mother_branch, const Orientation& child_branch_orient);
 
 	/// This function searches the facet which a child branch represented
 	/// by a line will be fused with.
@@ -347,12 +406,13 @@ class SurfaceTopology
 	/// \return The status of search.
 	bool searchFusionFacetForChildBranch(Line& child_branch_line, VertexHandle mother_branch_vertex, FacetHandle& child_fusion_facet);
 
-	/// This function writes the surface geometry of cell membrane into an OFF-format file.
+	/// This function writes the surface geometry of cell membrane and the
+	/// attributes of its filaments into a frame, which is either written
+	/// into a binary trajectory file or exported into an OFF-format file.
 	///
-	/// \param output the output stream.
-	/// \param delim the delimiter.
+	/// \param frame the frame whose time is kept.
 	/// \return No value is returned.
-	void exportGeometry(std::ofstream& output, char delim = ' ');
+	void exportGeometry(TrajectoryFrame& frame);
 };
 
 }
@@ -0,0 +1,163 @@
+#ifndef TRAJECTORYFILE_HPP_
+#define TRAJECTORYFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <Vec3.hpp>
+
+namespace motility
+{
+
+/// TrajectoryFrame struct is a snapshot of cell membrane surface, i.e.
+/// the locations of vertices at filament tips, the triangular facets and
+/// the attributes of the filaments at the vertices.
+struct TrajectoryFrame
+{
+	double time;
+
+	/// The generational ids of the filaments at the vertices, which
+	/// identify a vertex across frames.
+	std::vector<uint64_t> vertex_ids;
+
+	std::vector<Vec3d> locations;
+
+	std::vector<uint8_t> capped;
+
+	/// The numbers of actin monomers of the filaments.
+	std::vector<uint32_t> lengths;
+
+	/// The vertex indices of the facets, three per facet.
+	std::vector<uint32_t> facets;
+
+	size_t getVertexSize() const;
+
+	size_t getFacetSize() const;
+
+	/// This function writes the frame into an OFF-format file.
+	///
+	/// \param output the output stream.
+	/// \param delim the delimiter.
+	/// \return No value is returned.
+	void exportGeometry(std::ostream& output, char delim = ' ') const;
+};
+
+/// TrajectoryWriter class writes the snapshots of cell membrane surface
+/// of a simulation into a single binary trajectory file.
+///
+/// The file begins with a header and is followed by one chunk per frame
+/// and an index footer. A chunk is either a key frame, which holds the
+/// topology, i.e. the vertex ids and the facets, and the absolute vertex
+/// locations, or a delta frame, which holds the changes of the vertex
+/// locations from the previous frame. The locations are quantized on a
+/// grid of 2^-20 um and encoded as variable-length integers, so that the
+/// vertices which stay still cost one byte per coordinate. A key frame
+/// is written whenever the topology changes, and at least once every
+/// key_frame_interval frames to bound the decoding of a random frame.
+/// The vertex ids and the facet indices of a key frame are encoded as the
+/// variable-length differences from their predecessors. The capping
+/// states are packed into bits and the filament lengths are encoded as
+/// variable-length integers in every frame.
+///
+/// The footer lists the time, the offset and the key frame of every
+/// frame for random access, and the file ends with the offset of the
+/// footer. All numbers are little-endian.
+class TrajectoryWriter
+{
+	std::string name;
+
+	std::ofstream stream;
+
+	/// The time, the offset and the offset of the key frame of every
+	/// written frame.
+	std::vector<double> frame_times;
+
+	std::vector<uint64_t> frame_offsets;
+
+	std::vector<uint64_t> key_frame_offsets;
+
+	/// The topology and the quantized locations of the previous frame.
+	std::vector<uint64_t> last_vertex_ids;
+
+	std::vector<uint32_t> last_facets;
+
+	std::vector<int64_t> last_locations;
+
+	size_t frames_since_key_frame;
+
+	/// The buffer of the chunk being written.
+	std::vector<uint8_t> chunk;
+
+  public:
+
+	/// TrajectoryWriter constructor function, which creates the file
+	/// and writes the header.
+	TrajectoryWriter(const std::string& fn);
+
+	/// The footer is written when the writer is destroyed.
+	~TrajectoryWriter();
+
+	std::string getName() const;
+
+	bool isOpen() const;
+
+	size_t getFrameSize() const;
+
+	void write(const TrajectoryFrame& frame);
+
+	/// This function writes the footer and closes the file.
+	void close();
+};
+
+/// TrajectoryReader class reads the frames of a binary trajectory file.
+///
+/// The frames are located through the index footer. If the footer is
+/// missing, e.g. when the simulation is interrupted, the chunks are
+/// scanned from the beginning instead.
+class TrajectoryReader
+{
+	std::ifstream stream;
+
+	double quantum;
+
+	std::vector<double> frame_times;
+
+	std::vector<uint64_t> frame_offsets;
+
+	std::vector<uint64_t> key_frame_offsets;
+
+  private:
+
+	bool readIndex();
+
+	bool scanChunks();
+
+	/// This function reads the chunk at a given offset into a frame,
+	/// where a delta frame is applied to the previous frame.
+	bool readChunk(uint64_t offset, TrajectoryFrame& frame, std::vector<int64_t>& locations);
+
+  public:
+
+	TrajectoryReader();
+
+	/// This function opens a trajectory file and reads its index.
+	///
+	/// \param fn the name of the file.
+	/// \return A boolean status indicating whether or not the file is a
+	/// valid trajectory file.
+	bool open(const std::string& fn);
+
+	size_t getFrameSize() const;
+
+	double getFrameTime(size_t k) const;
+
+	/// This function reads the k-th frame by decoding from its key frame.
+	bool read(size_t k, TrajectoryFrame& frame);
+};
+
+}
+
+#endif /*TRAJECTORYFILE_HPP_*/
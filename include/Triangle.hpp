@@ -3,7 +3,7 @@
 
 #include <iostream>
 #include <Coordinate.hpp>
-#include <Vector.hpp>
+#include <Vec3.hpp>
 
 namespace motility
 {
@@ -17,7 +17,8 @@ class Triangle
 
 	CartesianCoordinate center;
 
-	Vector normal;
+	/// The unit normal vector
+	Vec3d normal;
 
 	double area;
 
@@ -35,7 +36,7 @@ class Triangle
 
 	const CartesianCoordinate& getCenter() const;
 
-	Vector& getNormal();
+	const Vec3d& getNormal() const;
 
 	double getArea() const;
 
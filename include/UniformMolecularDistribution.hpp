@@ -10,7 +10,7 @@ namespace motility
 ///
 /// Uniform molecular distribution is described by a single qunatity, usually
 /// molecular density, throught out the spatial region between boundaries.
-class UniformMolecularDistribution : public MolecularDistribution 
+class UniformMolecularDistribution final : public MolecularDistribution
 {
   private:
 
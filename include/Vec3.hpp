@@ -0,0 +1,168 @@
+#ifndef VEC3_HPP_
+#define VEC3_HPP_
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace motility
+{
+
+/// Vec3 struct is the lean 3-component type of the geometric kernels.
+///
+/// Unlike Vector, it caches neither its magnitude nor its orientation,
+/// so it is trivially copyable, every operation is free of side effects
+/// and can be evaluated on const references or at compile time, except
+/// for norm() which needs std::sqrt. A point is represented by the
+/// vector from the origin, named Point3 for readability.
+///
+/// CartesianCoordinate and Vector convert to and from Vec3<double> and
+/// remain the types of the interfaces and of the output files.
+template<typename T>
+struct Vec3
+{
+	T x, y, z;
+
+	constexpr Vec3() : x(0), y(0), z(0) {}
+
+	constexpr Vec3(T xx, T yy, T zz) : x(xx), y(yy), z(zz) {}
+
+	/// The conversion between precisions is explicit, since narrowing
+	/// rounds every component.
+	template<typename U>
+	constexpr explicit Vec3(const Vec3<U>& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)) {}
+
+	constexpr Vec3 operator-() const
+	{
+		return Vec3(-x, -y, -z);
+	}
+
+	constexpr Vec3 operator+(const Vec3& v) const
+	{
+		return Vec3(x + v.x, y + v.y, z + v.z);
+	}
+
+	constexpr Vec3 operator-(const Vec3& v) const
+	{
+		return Vec3(x - v.x, y - v.y, z - v.z);
+	}
+
+	constexpr Vec3 operator*(T r) const
+	{
+		return Vec3(x * r, y * r, z * r);
+	}
+
+	constexpr Vec3 operator/(T r) const
+	{
+		return Vec3(x / r, y / r, z / r);
+	}
+
+	constexpr Vec3& operator+=(const Vec3& v)
+	{
+		x += v.x; y += v.y; z += v.z;
+		return *this;
+	}
+
+	constexpr Vec3& operator-=(const Vec3& v)
+	{
+		x -= v.x; y -= v.y; z -= v.z;
+		return *this;
+	}
+
+	constexpr Vec3& operator*=(T r)
+	{
+		x *= r; y *= r; z *= r;
+		return *this;
+	}
+
+	constexpr Vec3& operator/=(T r)
+	{
+		x /= r; y /= r; z /= r;
+		return *this;
+	}
+
+	constexpr bool operator==(const Vec3& v) const
+	{
+		return (x == v.x && y == v.y && z == v.z);
+	}
+
+	constexpr bool operator!=(const Vec3& v) const
+	{
+		return !(*this == v);
+	}
+};
+
+static_assert(std::is_trivially_copyable<Vec3<double>>::value, "Vec3 must be trivially copyable");
+
+static_assert(std::is_trivially_copyable<Vec3<float>>::value, "Vec3 must be trivially copyable");
+
+template<typename T>
+using Point3 = Vec3<T>;
+
+typedef Vec3<double> Vec3d;
+
+typedef Vec3<float> Vec3f;
+
+typedef Point3<double> Point3d;
+
+template<typename T>
+constexpr Vec3<T> operator*(T r, const Vec3<T>& v)
+{
+	return v * r;
+}
+
+template<typename T>
+constexpr T dot(const Vec3<T>& v1, const Vec3<T>& v2)
+{
+	return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
+
+template<typename T>
+constexpr Vec3<T> cross(const Vec3<T>& v1, const Vec3<T>& v2)
+{
+	return Vec3<T>(v1.y * v2.z - v2.y * v1.z, v1.z * v2.x - v2.z * v1.x, v1.x * v2.y - v2.x * v1.y);
+}
+
+template<typename T>
+constexpr T normSquared(const Vec3<T>& v)
+{
+	return v.x * v.x + v.y * v.y + v.z * v.z;
+}
+
+template<typename T>
+inline T norm(const Vec3<T>& v)
+{
+	return std::sqrt(normSquared(v));
+}
+
+template<typename T>
+inline Vec3<T> normalized(const Vec3<T>& v)
+{
+	return v * (1 / norm(v));
+}
+
+/// These functions flush the results whose magnitudes are below the
+/// machine epsilon to zero, as dotProd() and crossProd() of Vector, on
+/// which the tolerance tests of the geometric algorithms rely.
+template<typename T>
+constexpr T flushToZero(T f)
+{
+	return ((f < 0 ? -f : f) < std::numeric_limits<T>::epsilon() ? T(0) : f);
+}
+
+template<typename T>
+constexpr T dotProd(const Vec3<T>& v1, const Vec3<T>& v2)
+{
+	return flushToZero(dot(v1, v2));
+}
+
+template<typename T>
+constexpr Vec3<T> crossProd(const Vec3<T>& v1, const Vec3<T>& v2)
+{
+	Vec3<T> v = cross(v1, v2);
+	return Vec3<T>(flushToZero(v.x), flushToZero(v.y), flushToZero(v.z));
+}
+
+}
+
+#endif /*VEC3_HPP_*/
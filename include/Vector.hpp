@@ -42,6 +42,12 @@ class Vector
 
 	Vector(const CartesianCoordinate& bp, const CartesianCoordinate& ep);
 
+	/// These functions convert a vector to and from the lean type of the
+	/// geometric kernels, without caching its magnitude or orientation.
+	explicit Vector(const Vec3d& v);
+
+	Vec3d toVec3() const;
+
 	void clearMag();
 
 	void clearOrient();
@@ -77,15 +83,15 @@ class Vector
 
 	const Vector& operator+() const;
 
-	const Vector operator-() const;
+	Vector operator-() const;
 
-	const Vector operator+(const Vector& v) const;
+	Vector operator+(const Vector& v) const;
 
-	const Vector operator-(const Vector& v) const;
+	Vector operator-(const Vector& v) const;
 
-	const Vector operator*(double r) const;
+	Vector operator*(double r) const;
 
-	const Vector operator/(double r) const;
+	Vector operator/(double r) const;
 
 	Vector& operator+=(const Vector& v);
 
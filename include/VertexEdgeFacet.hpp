@@ -3,6 +3,7 @@
 
 #include <typedefs.hpp>
 #include <Coordinate.hpp>
+#include <GeometryPrecision.hpp>
 #include <Vector.hpp>
 #include <Triangle.hpp>
 #include <FilamentBranch.hpp>
@@ -35,6 +36,9 @@ class Vertex
 	/// the member function addFacet() of Membrane which also
 	/// sorts these edges clockwised.
 
+	/// The epoch of the last VertexSet containing this vertex.
+	size_t mark;
+
   public:
 
 	Vertex();
@@ -49,6 +53,10 @@ class Vertex
 
 	CartesianCoordinate getLocation() const;
 
+	size_t getMark() const;
+
+	void setMark(size_t m);
+
 	bool operator==(const Vertex& v) const;
 
 	bool operator!=(const Vertex& v) const;
@@ -120,10 +128,16 @@ class Facet
 	EdgeHandle edges[3];
 
 	/// The area of this facet
-	double area;
+	GeometryPrecision::storage_type area;
 
-	/// The normal vector of this facet
-	Vector normal;
+	/// The range of FacetGrid cells in which this facet is registered
+	long grid_range[6];
+
+	/// Whether or not this facet is registered in FacetGrid
+	bool grid_flag;
+
+	/// The stamp of the last FacetGrid query reporting this facet
+	size_t grid_stamp;
 
   public:
 
@@ -148,6 +162,8 @@ class Facet
 	friend class Edge;
 
 	friend class SurfaceTopology;
+
+	friend class FacetGrid;
 };
 
 inline VertexHandle vertex_handle_null {};
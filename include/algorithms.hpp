@@ -26,8 +26,10 @@
 #include <string>
 #include <sstream>
 #include <list>
+#include <memory_resource>
 #include <algorithm>
 #include <Coordinate.hpp>
+#include <Vec3.hpp>
 #include <Vector.hpp>
 #include <Line.hpp>
 #include <Triangle.hpp>
@@ -77,44 +79,48 @@ bool selectFromHistogram(const double* hist_dist, size_t size, size_t& index);
 
 // This function calculates the directional distance from
 // a gvien point to the plane of a given triangle.
-double distance(const CartesianCoordinate& point, Triangle& triangle);
+double distance(const CartesianCoordinate& point, const Triangle& triangle);
 
 // This function determines if a given point is in the place
 // of a given triangle.
-bool isInPlane(const CartesianCoordinate& point, Triangle& triangle);
+bool isInPlane(const CartesianCoordinate& point, const Triangle& triangle);
 
 // This function calculates the projection spot of a given
 // point onto the plane of a given triangle. The projection
 // point may lie outside of the given triangle.
-CartesianCoordinate projection(const CartesianCoordinate& point, Triangle& triangle);
+CartesianCoordinate projection(const CartesianCoordinate& point, const Triangle& triangle);
 
 // This function calculates the homogeneous Barycentric
 // coordinates of a given point with respect to a given
 // triangle.
-CartesianCoordinate barycentric(const CartesianCoordinate& point, Triangle& triangle);
+CartesianCoordinate barycentric(const CartesianCoordinate& point, const Triangle& triangle);
 
-bool isInsideTriangle(const CartesianCoordinate& point, Triangle& triangle);
+// This function determines if a given point in the plane of
+// a given triangle is inside the triangle.
+bool isInsideTriangle(const CartesianCoordinate& point, const Triangle& triangle);
 
 // This function determines if the projection spot of a given
 // point is inside a given triangle.
-bool isProjectionInsideTriangle(const CartesianCoordinate& point, Triangle& triangle);
+bool isProjectionInsideTriangle(const CartesianCoordinate& point, const Triangle& triangle);
 
-// This function uses the Barycentric coordinates to determine
+// This function uses exact orientation predicates to determine
 // if a given line intersects with a given triangle.
-bool isIntersecting(Line& line, Triangle& triangle);
+bool isIntersecting(const Line& line, const Triangle& triangle);
 
 // This function determins whether a given point is inside a
 // given triangular box.
-bool isInsideTriangularBox(const CartesianCoordinate& point, Triangle& triangle, double height);
+bool isInsideTriangularBox(const CartesianCoordinate& point, const Triangle& triangle, double height);
 
 // This function calculates the intersection point between the
 // the orientation defined by the line and the plane defined by
 // the triangle.
-CartesianCoordinate intersection(Line& line, Triangle& triangle);
+CartesianCoordinate intersection(const Line& line, const Triangle& triangle);
 
 double angle(Vector& v1, Vector& v2);
 
-double angle(Triangle& t1, Triangle& t2);
+double angle(const Vec3d& v1, const Vec3d& v2);
+
+double angle(const Triangle& t1, const Triangle& t2);
 
 /// This function mapps a point from original coordinate system
 /// to rotated coordinate system, or versus.
@@ -153,26 +159,14 @@ int uitoi(unsigned int i);
 
 long ultol(unsigned long i);
 
+// This function appends an element to a short list unless it is
+// contained. Sets of vertices and filaments are built with FlatSet
+// instead.
 template<typename T>
-bool isContained(const std::list<T>& l, const T& x)
-{
-	bool contained_flag = false;
-	for(typename std::list<T>::const_iterator it = l.begin(); it != l.end(); ++it)
-	{
-		if(x == *it)
-		{
-			contained_flag = true;
-			break;
-		}
-	}
-	return contained_flag;
-}
-
-template<typename T>
-bool unique_append(std::list<T>& l, const T& x)
+bool unique_append(std::pmr::list<T>& l, const T& x)
 {
 	bool action_flag = true;
-	for(typename std::list<T>::iterator it = l.begin(); it != l.end(); ++it)
+	for(typename std::pmr::list<T>::iterator it = l.begin(); it != l.end(); ++it)
 	{
 		if(x == *it)
 		{
@@ -184,39 +178,6 @@ bool unique_append(std::list<T>& l, const T& x)
 	return action_flag;
 }
 
-template<typename T>
-std::list<T> merge(const std::list<T>& l1, const std::list<T>& l2)
-{
-	std::list<T> l3;
-	for(typename std::list<T>::const_iterator it1 = l1.begin(); it1 != l1.end(); ++it1)
-	{
-		bool redundant_flag = false;
-		for(typename std::list<T>::const_iterator it3 = l3.begin(); it3 != l3.end(); ++it3)
-		{
-			if(*it1 == *it3)
-			{
-				redundant_flag = true;
-				break;
-			}
-		}
-		if(!redundant_flag) l3.push_back(*it1);
-	}
-	for(typename std::list<T>::const_iterator it2 = l2.begin(); it2 != l2.end(); ++it2)
-	{
-		bool redundant_flag = false;
-		for(typename std::list<T>::const_iterator it3 = l3.begin(); it3 != l3.end(); ++it3)
-		{
-			if(*it2 == *it3)
-			{
-				redundant_flag = true;
-				break;
-			}
-		}
-		if(!redundant_flag) l3.push_back(*it2);
-	}
-	return l3;
-}
-
 }
 
 #endif /*ALGORITHMS_HPP_*/
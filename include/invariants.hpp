@@ -0,0 +1,46 @@
+//
+// Principle
+//
+// The invariants of the simulation are checked in three tiers:
+//
+// 0) Off: no invariant is checked. This is the tier of an optimized build,
+// where NDEBUG is defined.
+//
+// 1) Cheap: the preconditions and the results of individual operations are
+// checked by assert(), whose costs are constant or proportional to the size
+// of a local surface. This is the tier of a build without NDEBUG.
+//
+// 2) Expensive: the whole membrane surface is further validated after each
+// topological change, which costs time proportional to the size of cell
+// membrane and is meant for debugging the surface algorithms. This tier is
+// selected by defining EXPENSIVE_INVARIANT_CHECKS without NDEBUG.
+//
+// No check has any side effect, so the trajectory of a fixed random seed
+// does not depend on the tier.
+//
+#ifndef INVARIANTS_HPP_
+#define INVARIANTS_HPP_
+
+#include <cassert>
+
+#define INVARIANT_CHECKS_OFF 0
+#define INVARIANT_CHECKS_CHEAP 1
+#define INVARIANT_CHECKS_EXPENSIVE 2
+
+#if defined(NDEBUG)
+#define INVARIANT_CHECK_LEVEL INVARIANT_CHECKS_OFF
+#elif defined(EXPENSIVE_INVARIANT_CHECKS)
+#define INVARIANT_CHECK_LEVEL INVARIANT_CHECKS_EXPENSIVE
+#else
+#define INVARIANT_CHECK_LEVEL INVARIANT_CHECKS_CHEAP
+#endif
+
+// The condition of an expensive check is not evaluated below the expensive
+// tier.
+#if INVARIANT_CHECK_LEVEL >= INVARIANT_CHECKS_EXPENSIVE
+#define EXPENSIVE_ASSERT(cond) assert(cond)
+#else
+#define EXPENSIVE_ASSERT(cond) ((void)0)
+#endif
+
+#endif /*INVARIANTS_HPP_*/
@@ -0,0 +1,275 @@
+//
+// Principle
+//
+// The math kernels evaluate the elementary functions on the hot paths of
+// the simulation, i.e. the Boltzmann factors of the resistance of cell
+// membrane, the logarithms of the sampled waiting times, the exponentials
+// of nucleotide aging and the trigonometric functions of filament
+// orientations.
+//
+// Each kernel comes in two versions. The exact version calls the standard
+// library. The fast version reduces the argument by exact operations and
+// evaluates a fixed polynomial, branching only on the range checks, so it
+// can be inlined and vectorized, and its relative error stays below 1e-10
+// over the documented range. The Boltzmann factor is the fast exponential
+// of the negated ratio of energy change to kT.
+//
+// The build option FAST_MATH_KERNELS selects the fast versions as the
+// kernels in namespace math, which are used by the simulation. Otherwise
+// the exact versions are used and the results are unchanged.
+//
+#ifndef MATHKERNELS_HPP_
+#define MATHKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace simulation
+{
+
+namespace exact
+{
+
+inline double exp(double x)
+{
+	return std::exp(x);
+}
+
+inline double log(double x)
+{
+	return std::log(x);
+}
+
+inline void sincos(double x, double& s, double& c)
+{
+	s = std::sin(x);
+	c = std::cos(x);
+}
+
+inline double tan(double x)
+{
+	return std::tan(x);
+}
+
+inline double asin(double x)
+{
+	return std::asin(x);
+}
+
+// This function returns exp(-x) for the ratio x >= 0 of an energy change
+// to kT.
+inline double boltzmannFactor(double x)
+{
+	return std::exp(-x);
+}
+
+}
+
+namespace fast
+{
+
+namespace detail
+{
+
+constexpr double log2e = 1.4426950408889634;
+
+// The constants ln(2) and pi/2 are split such that the product of the
+// high part with a small integer is exact.
+constexpr double ln2_hi = 6.93147180369123816490e-01;
+
+constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+constexpr double pio2_hi = 1.57079632673412561417e+00;
+
+constexpr double pio2_lo = 6.07710050650619224932e-11;
+
+constexpr double two_over_pi = 6.36619772367581382433e-01;
+
+constexpr double sqrt2 = 1.41421356237309504880;
+
+// Adding and subtracting 1.5 * 2^52 rounds a double of magnitude below
+// 2^51 to the nearest integer without a call to the math library.
+constexpr double round_shift = 6755399441055744.0;
+
+constexpr size_t asin_terms = 15;
+
+// The coefficients of the Maclaurin series of asin(x), i.e.
+// (2n)! / (4^n (n!)^2 (2n+1)) for n = 0, 1, ...
+struct AsinCoefficients
+{
+	double c[asin_terms];
+
+	constexpr AsinCoefficients() : c()
+	{
+		double binomial = 1;
+		for(size_t n = 0; n < asin_terms; ++n)
+		{
+			c[n] = binomial / (2 * n + 1);
+			binomial *= static_cast<double>(2 * n + 1) / static_cast<double>(2 * n + 2);
+		}
+	}
+};
+
+constexpr AsinCoefficients asin_coefficients;
+
+inline uint64_t toBits(double x)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	return bits;
+}
+
+inline double fromBits(uint64_t bits)
+{
+	double x;
+	std::memcpy(&x, &bits, sizeof(x));
+	return x;
+}
+
+// This function returns exp(r) for |r| <= ln(2)/2 by its Taylor polynomial
+// of degree 11.
+inline double expReduced(double r)
+{
+	double p = 1.0 / 39916800;
+	p = p * r + 1.0 / 3628800;
+	p = p * r + 1.0 / 362880;
+	p = p * r + 1.0 / 40320;
+	p = p * r + 1.0 / 5040;
+	p = p * r + 1.0 / 720;
+	p = p * r + 1.0 / 120;
+	p = p * r + 1.0 / 24;
+	p = p * r + 1.0 / 6;
+	p = p * r + 0.5;
+	p = p * r + 1;
+	return p * r + 1;
+}
+
+// This function returns asin(x) for |x| <= 1/2 by its Maclaurin series.
+inline double asinReduced(double x)
+{
+	double z = x * x;
+	double p = asin_coefficients.c[asin_terms - 1];
+	for(size_t n = asin_terms - 1; n > 0; --n) p = p * z + asin_coefficients.c[n - 1];
+	return x * p;
+}
+
+}
+
+// This function returns exp(x) for x in [-708, 709], and 0 below and
+// infinity above this range.
+inline double exp(double x)
+{
+	if(!(x >= -708)) return (x == x ? 0 : x);
+	if(x > 709) return HUGE_VAL;
+	// exp(x) = 2^n * exp(r) with |r| <= ln(2)/2.
+	double n = (x * detail::log2e + detail::round_shift) - detail::round_shift;
+	double r = (x - n * detail::ln2_hi) - n * detail::ln2_lo;
+	uint64_t scale = static_cast<uint64_t>(static_cast<int64_t>(n) + 1023) << 52;
+	return detail::expReduced(r) * detail::fromBits(scale);
+}
+
+// This function returns log(x) for any x, which is -infinity at zero and
+// NaN below zero as the standard library.
+inline double log(double x)
+{
+	// log(x) = e * ln(2) + log(m) with m in [sqrt(2)/2, sqrt(2)), and
+	// log(m) = 2 * atanh(s) with s = (m - 1) / (m + 1), |s| < 0.172.
+	// A subnormal x is first scaled into the normal range. The special
+	// cases are selected at the end so that the loop of a caller has no
+	// branch.
+	bool subnormal = (x < DBL_MIN);
+	double xs = (subnormal ? x * 18014398509481984.0 : x);
+	uint64_t bits = detail::toBits(xs);
+	// The biased exponent is converted to double by placing it in the
+	// mantissa of 2^52, which avoids an integer conversion.
+	double e = (detail::fromBits((bits >> 52) | 0x4330000000000000ULL) - 4503599627370496.0) - (subnormal ? 1077 : 1023);
+	double m = detail::fromBits((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+	bool upper = (m > detail::sqrt2);
+	m = (upper ? m * 0.5 : m);
+	e = (upper ? e + 1 : e);
+	double s = (m - 1) / (m + 1);
+	double z = s * s;
+	double p = 1.0 / 13;
+	p = p * z + 1.0 / 11;
+	p = p * z + 1.0 / 9;
+	p = p * z + 1.0 / 7;
+	p = p * z + 1.0 / 5;
+	p = p * z + 1.0 / 3;
+	p = p * z + 1;
+	double y = e * detail::ln2_hi + (e * detail::ln2_lo + 2 * s * p);
+	y = (x <= DBL_MAX ? y : x);
+	y = (x == 0 ? -HUGE_VAL : y);
+	return (x >= 0 ? y : std::numeric_limits<double>::quiet_NaN());
+}
+
+// This function returns sin(x) and cos(x) for |x| up to 1e5, which covers
+// any angle of an orientation.
+inline void sincos(double x, double& s, double& c)
+{
+	// The argument is reduced to r = x - k * pi/2 with |r| <= pi/4,
+	// and the quadrant k selects the signs and the roles of the
+	// Taylor polynomials of sin(r) and cos(r).
+	double k = (x * detail::two_over_pi + detail::round_shift) - detail::round_shift;
+	double r = (x - k * detail::pio2_hi) - k * detail::pio2_lo;
+	double z = r * r;
+	double sr = -1.0 / 39916800;
+	sr = sr * z + 1.0 / 362880;
+	sr = sr * z - 1.0 / 5040;
+	sr = sr * z + 1.0 / 120;
+	sr = sr * z - 1.0 / 6;
+	sr = r + r * z * sr;
+	double cr = 1.0 / 479001600;
+	cr = cr * z - 1.0 / 3628800;
+	cr = cr * z + 1.0 / 40320;
+	cr = cr * z - 1.0 / 720;
+	cr = cr * z + 1.0 / 24;
+	cr = cr * z - 0.5;
+	cr = 1 + z * cr;
+	int64_t quadrant = static_cast<int64_t>(k) & 3;
+	double swapped_s = ((quadrant & 1) ? cr : sr);
+	double swapped_c = ((quadrant & 1) ? sr : cr);
+	s = ((quadrant & 2) ? -swapped_s : swapped_s);
+	c = (((quadrant + 1) & 2) ? -swapped_c : swapped_c);
+}
+
+inline double tan(double x)
+{
+	double s, c;
+	sincos(x, s, c);
+	return s / c;
+}
+
+// This function returns asin(x) for |x| <= 1.
+inline double asin(double x)
+{
+	double a = std::fabs(x);
+	// asin(a) = pi/2 - 2 * asin(sqrt((1 - a) / 2)) for a > 1/2, so a
+	// single series is evaluated in either case.
+	bool lower = (a <= 0.5);
+	double p = detail::asinReduced(lower ? a : std::sqrt((1 - a) * 0.5));
+	double y = (lower ? p : (detail::pio2_hi - 2 * p) + detail::pio2_lo);
+	return std::copysign(y, x);
+}
+
+// This function returns exp(-x) for the ratio x of an energy change to
+// kT.
+inline double boltzmannFactor(double x)
+{
+	return exp(-x);
+}
+
+}
+
+#ifdef FAST_MATH_KERNELS
+namespace math = fast;
+#else
+namespace math = exact;
+#endif
+
+}
+
+#endif /*MATHKERNELS_HPP_*/
@@ -0,0 +1,48 @@
+//
+// Principle
+//
+// The geometric predicates answer the sign questions on which the topological
+// decisions of membrane surface rely, e.g. on which side of a facet a point
+// lies. They return -1, 0 or 1, and the answer is always exact for the given
+// floating-point coordinates.
+//
+// Each predicate is first evaluated in floating-point arithmetic together with
+// a running bound of its rounding error. Only when the magnitude of the result
+// does not exceed this bound, which happens in nearly degenerate configurations,
+// the predicate is evaluated again in exact expansion arithmetic (Shewchuk J.R.
+// 1997). Therefore the common case costs little more than a plain evaluation.
+//
+#ifndef PREDICATES_HPP_
+#define PREDICATES_HPP_
+
+#include <Coordinate.hpp>
+
+namespace motility
+{
+
+// This function determines the side of the plane through a, b and c on
+// which d lies. It returns the sign of the determinant:
+//
+//             | b.x - a.x   b.y - a.y   b.z - a.z |
+//             | c.x - a.x   c.y - a.y   c.z - a.z |
+//             | d.x - a.x   d.y - a.y   d.z - a.z |
+//
+// which is positive if d lies on the side pointed to by the normal vector
+// (b - a) x (c - a), negative on the opposite side and zero if the four
+// points are coplanar.
+int orient3d(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& d);
+
+// This function determines on which side of the edge from a to b the
+// projection of p onto the plane of the triangle (a, b, c) lies. It
+// returns the sign of:
+//
+//             ((b - a) x (c - a)) * ((b - a) x (p - a))
+//
+// which is positive if the projection lies on the same side as c, negative
+// on the opposite side and zero if it lies on the line through a and b.
+// This incircle-style predicate is of degree four in the coordinates.
+int orientInPlane(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& p);
+
+}
+
+#endif /*PREDICATES_HPP_*/
@@ -0,0 +1,35 @@
+#ifndef SAMPLEDENSITY_HPP_
+#define SAMPLEDENSITY_HPP_
+
+#include <MolecularDistribution.hpp>
+#include <UniformMolecularDistribution.hpp>
+#include <NonUniformMolecularDistribution.hpp>
+#include <SubstratePatternDistribution.hpp>
+
+namespace motility
+{
+
+/// This function returns the density of a distribution at a location by
+/// dispatching on the kind of the distribution, such that the density of
+/// a final distribution is sampled by a direct call instead of a virtual
+/// call. The distributions of other kinds are sampled virtually.
+///
+/// \param dist the molecular distribution.
+/// \param loc the spatial location.
+/// \return molecular density.
+inline double sampleDensity(MolecularDistribution& dist, const CartesianCoordinate& loc)
+{
+	double dens;
+	switch(dist.getKind())
+	{
+		case MolecularDistribution::UNIFORM: dens = static_cast<UniformMolecularDistribution&>(dist).UniformMolecularDistribution::getDensity(loc); break;
+		case MolecularDistribution::NON_UNIFORM: dens = static_cast<NonUniformMolecularDistribution&>(dist).NonUniformMolecularDistribution::getDensity(loc); break;
+		case MolecularDistribution::SUBSTRATE_PATTERN: dens = static_cast<SubstratePatternDistribution&>(dist).SubstratePatternDistribution::getDensity(loc); break;
+		default: dens = dist.getDensity(loc); break;
+	}
+	return dens;
+}
+
+}
+
+#endif /*SAMPLEDENSITY_HPP_*/
@@ -1,6 +1,6 @@
+#include <utility>
 #include <BranchTree.hpp>
 #include <VertexEdgeFacet.hpp>
-#include <ParameterTable.hpp>
 #include <algorithms.hpp>
 
 namespace motility
@@ -12,7 +12,7 @@ BranchTree::~BranchTree() {}
 
 BranchTree::BranchTree(const ARP23& arp23, const Actin& actin, const Orientation& orient)
 {
-	branches.push_back(FilamentBranch(arp23, actin, orient));
+	branches.emplace_back(arp23, actin, orient);
 }
 
 BranchTree::BranchTree(const FilamentBranch& branch)
@@ -20,47 +20,107 @@ BranchTree::BranchTree(const FilamentBranch& branch)
 	branches.push_back(branch);
 }
 
+BranchTree::BranchTree(FilamentBranch&& branch)
+{
+	branches.push_back(std::move(branch));
+}
+
 void BranchTree::addFilamentBranch(const ARP23& arp23, const Actin& actin, const Orientation& orient, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle)
 {
 	ARP23 newArp23(arp23);
 	newArp23.setLocation(parent_handle->getBranchingSiteActinLocation());
-	addFilamentBranch(FilamentBranch(newArp23, actin, orient), parent_handle, tree_handle);
+	branches.emplace_back(newArp23, actin, orient);
+	linkLastFilamentBranch(parent_handle, tree_handle);
 }
 
 void BranchTree::addFilamentBranch(const FilamentBranch& branch, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle)
 {
-	size_t arp23_binding_actins = strtoul((ParameterTable::instance())[std::string("arp23_binding_actins")]);
 	branches.push_back(branch);
+	linkLastFilamentBranch(parent_handle, tree_handle);
+}
+
+void BranchTree::addFilamentBranch(FilamentBranch&& branch, FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle)
+{
+	branches.push_back(std::move(branch));
+	linkLastFilamentBranch(parent_handle, tree_handle);
+}
+
+void BranchTree::linkLastFilamentBranch(FilamentBranchHandle parent_handle, BranchTreeHandle tree_handle)
+{
 	FilamentBranchHandle childHandle = --(branches.end());
 	childHandle->setParentHandle(parent_handle);
 	childHandle->setTreeHandle(tree_handle);
 	childHandle->setNthChildOfParent(parent_handle->sizeofChildHandles());
 	parent_handle->addChildHandle(childHandle);
-	long child_location_on_filament = parent_handle->length() - arp23_binding_actins / 2 - 1;
-	// 'child_location_on_filament' is calculated in a way such
-	// that an ARP23 molecule binds to 'arp23_binding_actins'
-	// number of polymerized actin monomers on mother filament
-	// starting from filament barbed end immediately.
-	assert(child_location_on_filament >= 0);
-	parent_handle->addChildLocation(child_location_on_filament);
+	// The child filament is located at the ARP23-binding site
+	// of mother filament.
+	parent_handle->addChildLocation(parent_handle->getBranchingSiteActinIndex());
 }
 
-void BranchTree::removeFilamentBranch(FilamentBranchHandle fbh)
+void BranchTree::unlinkFilamentBranch(FilamentBranchHandle fbh)
 {
-	//
-	// To be implemented:
-	//
-	// Update the interlinking relationships between this filament
-	// and other filaments before removing it completely.
-	//
-	//
+	if(fbh->hasParent()) fbh->getParentHandle()->removeChildHandle(fbh);
+	fbh->setParentHandle(filament_branch_handle_null);
 	// Set the filament pointer of the corresponding vertex, if it
 	// exists, to 0 before remove the actin filament.
 	if(fbh->getVertex() != vertex_handle_null) fbh->getVertex()->setFilament(filament_branch_handle_null);
+}
+
+void BranchTree::removeFilamentBranch(FilamentBranchHandle fbh)
+{
+	// The subtrees of the child filaments must have been moved into
+	// their own filament trees.
+	assert(fbh->sizeofChildHandles() == 0);
+	unlinkFilamentBranch(fbh);
 	// Now remove the given actin filament from the filament pool.
 	branches.erase(fbh);
 }
 
+void BranchTree::moveFilamentSubtree(FilamentBranchHandle fbh, BranchTreeHandle tree_handle)
+{
+	assert(tree_handle->isEmpty());
+	// The filament keeps its vertex on cell membrane surface, so it is
+	// only unlinked from its parent filament.
+	if(fbh->hasParent()) fbh->getParentHandle()->removeChildHandle(fbh);
+	fbh->setParentHandle(filament_branch_handle_null);
+	fbh->setNthChildOfParent(0);
+	fbh->setTreeHandle(tree_handle);
+	tree_handle->branches.splice(tree_handle->branches.end(), branches, fbh);
+	spliceChildSubtrees(tree_handle);
+}
+
+void BranchTree::severFilamentBranch(FilamentBranchHandle fbh, size_t k, BranchTreeHandle tree_handle)
+{
+	assert(tree_handle->isEmpty());
+	FilamentBranches& new_branches = tree_handle->branches;
+	new_branches.push_back(fbh->sever(k));
+	FilamentBranchHandle root = new_branches.begin();
+	root->setTreeHandle(tree_handle);
+	FilamentBranchHandles& children = root->getChildHandles();
+	for(FilamentBranchHandleHandle fbhh = children.begin(); fbhh != children.end(); ++fbhh) (*fbhh)->setParentHandle(root);
+	spliceChildSubtrees(tree_handle);
+}
+
+void BranchTree::spliceChildSubtrees(BranchTreeHandle tree_handle)
+{
+	/// The filaments of the moved subtrees are spliced into the new
+	/// filament tree in breadth-first order. Splicing keeps their
+	/// handles valid, so only the tree handles need to be updated, and
+	/// the time is proportional to the size of the moved subtrees
+	/// rather than that of current tree.
+	FilamentBranches& new_branches = tree_handle->branches;
+	for(FilamentBranchHandle it = new_branches.begin(); it != new_branches.end(); ++it)
+	{
+		FilamentBranchHandles& children = it->getChildHandles();
+		for(FilamentBranchHandleHandle fbhh = children.begin(); fbhh != children.end(); ++fbhh)
+		{
+			FilamentBranchHandle child = *fbhh;
+			child->setTreeHandle(tree_handle);
+			new_branches.splice(new_branches.end(), branches, child);
+		}
+	}
+}
+
 bool BranchTree::isEmpty() const
 {
 	return branches.empty();
@@ -1,37 +1,38 @@
 #include <CellStatisticsCalculator.hpp>
+#include <vector>
 #include <MotileCell.hpp>
 #include <ParameterTable.hpp>
+#include <FilamentStateTable.hpp>
 #include <algorithms.hpp>
 
 namespace motility
 {
 
-CellStatisticsCalculator::CellStatisticsCalculator(MotileCell* cell, UniformMolecularDistribution* ecs_dist, double t, const std::string& data_dir)
+CellStatisticsCalculator::CellStatisticsCalculator(MotileCell* cell, MolecularDistribution* ecs_dist, double t, const std::string& data_dir)
 {
 	// Step 2:
 	// Initialize current time moment.
 	time_moment = t;
 	// Step 3:
 	// Open output files.
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	std::string cell_radius_dist_filename = data_dir + param_table[std::string("cell_radius_dist_filename")];
+	std::string cell_radius_dist_filename = data_dir + ParameterTable::lookup("cell_radius_dist_filename");
 	cell_radius_dist_file = new OutputFile(cell_radius_dist_filename);
-	std::string cell_velocity_dist_filename = data_dir + param_table[std::string("cell_velocity_dist_filename")];
+	std::string cell_velocity_dist_filename = data_dir + ParameterTable::lookup("cell_velocity_dist_filename");
 	cell_velocity_dist_file = new OutputFile(cell_velocity_dist_filename);
-	std::string cell_growing_dist_filename = data_dir + param_table[std::string("cell_growing_dist_filename")];
+	std::string cell_growing_dist_filename = data_dir + ParameterTable::lookup("cell_growing_dist_filename");
 	cell_growing_dist_file = new OutputFile(cell_growing_dist_filename);
-	std::string cell_devangle_dist_filename = data_dir + param_table[std::string("cell_devangle_dist_filename")];
+	std::string cell_devangle_dist_filename = data_dir + ParameterTable::lookup("cell_devangle_dist_filename");
 	cell_devangle_dist_file = new OutputFile(cell_devangle_dist_filename);
-	std::string cell_outward_dist_filename = data_dir + param_table[std::string("cell_outward_dist_filename")];
+	std::string cell_outward_dist_filename = data_dir + ParameterTable::lookup("cell_outward_dist_filename");
 	cell_outward_dist_file = new OutputFile(cell_outward_dist_filename);
-	std::string cell_stats_filename = data_dir + param_table[std::string("cell_stats_filename")];
+	std::string cell_stats_filename = data_dir + ParameterTable::lookup("cell_stats_filename");
 	cell_stats_file = new OutputFile(cell_stats_filename);
-	delimeter = param_table[std::string("delimeter")];
+	delimeter = ParameterTable::lookup("delimeter");
 	// Step 4:
 	// Calculate the number of periphery intervals.
-	double periphery_degree_interval = strtod(param_table[std::string("periphery_degree_interval")]);
-	double theta_min = strtod(param_table[std::string("theta_min")]);
-	double theta_max = strtod(param_table[std::string("theta_max")]);
+	double periphery_degree_interval = strtod(ParameterTable::lookup("periphery_degree_interval"));
+	double theta_min = strtod(ParameterTable::lookup("theta_min"));
+	double theta_max = strtod(ParameterTable::lookup("theta_max"));
 	double intervals = (theta_max - theta_min) / periphery_degree_interval;
 	assert(intervals >= 0);
 	double intervals_int = std::floor(intervals);
@@ -154,16 +155,36 @@ CellStatisticsCalculator::~CellStatisticsCalculator()
 	if(cell_stats_file != 0) delete cell_stats_file;
 }
 
-void CellStatisticsCalculator::collectSpreadingProperty(MotileCell* cell, UniformMolecularDistribution* ecs_dist, size_t* n_filament, double* radii, size_t* n_growing_filament, double* growing_percent, double* deviation_angles, size_t* n_outward_filament, double* outward_percent)
+void CellStatisticsCalculator::collectSpreadingProperty(MotileCell* cell, MolecularDistribution* ecs_dist, size_t* n_filament, double* radii, size_t* n_growing_filament, double* growing_percent, double* deviation_angles, size_t* n_outward_filament, double* outward_percent)
 {
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double periphery_degree_interval = strtod(param_table[std::string("periphery_degree_interval")]);
+	double periphery_degree_interval = strtod(ParameterTable::lookup("periphery_degree_interval"));
 	SurfaceTopology& membrane_surface = cell->getMembraneSurface();
-	Vertices& vertices = membrane_surface.getVertices();
-	for(VertexHandle vh = vertices.begin(); vh != vertices.end(); ++vh)
+	// The statistics only depend on the hot state of the filaments
+	// attached to membrane surface, so the dense state table is
+	// streamed instead of the vertex list. The order of filaments
+	// does not matter since only counts and maxima are collected.
+	// The extracellular densities at all filament tips are sampled in
+	// one batch before the filaments are visited.
+	FilamentStateTable::Table& state_table = FilamentStateTable::instance();
+	std::vector<size_t> ids;
+	std::vector<CartesianCoordinate> tips;
+	ids.reserve(state_table.size());
+	tips.reserve(state_table.size());
+	for(size_t id = 0; id < state_table.size(); ++id)
 	{
-		CartesianCoordinate vertex_location(vh->getLocation());
-		if(!isEqual(ecs_dist->getDensity(vertex_location), 0))
+		if(!state_table.isActive(id)) continue;
+		const FilamentState& state = state_table[id];
+		if(state.vertex == vertex_handle_null) continue;
+		ids.push_back(id);
+		tips.push_back(GeometryPrecision::loadCoordinate(state.tail_end_location));
+	}
+	std::vector<double> ecs_densities(tips.size());
+	ecs_dist->getDensities(tips.data(), tips.size(), ecs_densities.data());
+	for(size_t n = 0; n < ids.size(); ++n)
+	{
+		const FilamentState& state = state_table[ids[n]];
+		const CartesianCoordinate& vertex_location = tips[n];
+		if(!isEqual(ecs_densities[n], 0))
 		{
 			//
 			// For a fibroblast cell spreading on a plane of glass slide, the
@@ -182,9 +203,9 @@ void CellStatisticsCalculator::collectSpreadingProperty(MotileCell* cell, Unifor
 			if(p.rou > radii[i]) radii[i] = p.rou;
 			n_filament[i] += 1;
 			// Count the number of growing filaments.
-			if(!vh->getFilament()->isCapped()) n_growing_filament[i] += 1;
+			if(!state.capped) n_growing_filament[i] += 1;
 			// Record the maximum deviation angle.
-			double deviation_angle = membrane_surface.computeDeviationAngleOfFilamentGrowth(*(vh->getFilament()));
+			double deviation_angle = membrane_surface.computeDeviationAngleOfFilamentGrowth(state);
 			if(deviation_angle > deviation_angles[i]) deviation_angles[i] = deviation_angle;
 			// Count outward growing filaments.
 			if(deviation_angle < M_PI / 2) n_outward_filament[i] += 1;
@@ -240,7 +261,7 @@ void CellStatisticsCalculator::computeSpreadingVelocity(double* radii, double* n
 	}
 }
 
-void CellStatisticsCalculator::operator()(MotileCell* cell, UniformMolecularDistribution* ecs_dist, double t, bool file_saving_flag)
+void CellStatisticsCalculator::operator()(MotileCell* cell, MolecularDistribution* ecs_dist, double t, bool file_saving_flag)
 {
 	// Get the output file stream.
 	std::ofstream& cell_radius_dist_ostream = cell_radius_dist_file->getStream();
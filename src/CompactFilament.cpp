@@ -0,0 +1,251 @@
+#include <cassert>
+#include <cmath>
+#include <CompactFilament.hpp>
+#include <mathKernels.hpp>
+
+namespace motility
+{
+
+CompactFilament::CompactFilament()
+{
+	diameter = 0;
+	count = 0;
+}
+
+const CompactFilament::Run& CompactFilament::getRun(size_t i) const
+{
+	assert(i < count);
+	// The nucleotide state usually changes from the pointed end to the
+	// barbed end, so the runs are searched from the barbed end where
+	// most of the queries are made.
+	size_t n = count;
+	std::vector<Run>::const_reverse_iterator rit;
+	for(rit = runs.rbegin(); rit != runs.rend(); ++rit)
+	{
+		n -= rit->length;
+		if(i >= n) break;
+	}
+	assert(rit != runs.rend());
+	return *rit;
+}
+
+size_t CompactFilament::countState(std::uint8_t state) const
+{
+	size_t n = 0;
+	for(std::vector<Run>::const_iterator it = runs.begin(); it != runs.end(); ++it)
+	{
+		if(it->state == state) n += it->length;
+	}
+	return n;
+}
+
+void CompactFilament::setNucleotideBoundaries(size_t adp, size_t adpi)
+{
+	assert(adp + adpi <= count);
+	// The nucleotide states of Actin are encoded as 1 for ATP, 2 for
+	// ADP and 3 for ADP-Pi.
+	const size_t boundaries[3] = {adp, adp + adpi, count};
+	const std::uint8_t states[3] = {2, 3, 1};
+	std::vector<Run> new_runs;
+	new_runs.reserve(runs.size() + 2);
+	size_t pos = 0;
+	size_t segment = 0;
+	for(std::vector<Run>::const_iterator it = runs.begin(); it != runs.end(); ++it)
+	{
+		size_t end = pos + it->length;
+		// Split each run at the boundaries of nucleotide segments and
+		// merge the pieces with equal states.
+		while(pos < end)
+		{
+			while(boundaries[segment] <= pos) ++segment;
+			size_t piece_end = (end < boundaries[segment] ? end : boundaries[segment]);
+			std::uint32_t length = static_cast<std::uint32_t>(piece_end - pos);
+			if(!new_runs.empty() && new_runs.back().state == states[segment] && new_runs.back().bound_state == it->bound_state) new_runs.back().length += length;
+			else
+			{
+				Run r;
+				r.state = states[segment];
+				r.bound_state = it->bound_state;
+				r.length = length;
+				new_runs.push_back(r);
+			}
+			pos = piece_end;
+		}
+	}
+	runs.swap(new_runs);
+}
+
+void CompactFilament::setAnchor(const CartesianCoordinate& loc, const Vector& dir)
+{
+	assert(count == 0);
+	anchor = loc;
+	direction = dir;
+}
+
+void CompactFilament::push_back(const Actin& actin)
+{
+	if(count == 0) diameter = actin.getDiameter();
+	assert(actin.getDiameter() == diameter);
+	std::uint8_t state = static_cast<std::uint8_t>(actin.Molecule::getState());
+	std::uint8_t bound_state = static_cast<std::uint8_t>(actin.bstate);
+	if(!runs.empty() && runs.back().state == state && runs.back().bound_state == bound_state) ++runs.back().length;
+	else
+	{
+		Run r;
+		r.state = state;
+		r.bound_state = bound_state;
+		r.length = 1;
+		runs.push_back(r);
+	}
+	++count;
+}
+
+void CompactFilament::pop_back()
+{
+	assert(count > 0);
+	if(--runs.back().length == 0) runs.pop_back();
+	--count;
+}
+
+void CompactFilament::clear()
+{
+	runs.clear();
+	count = 0;
+}
+
+bool CompactFilament::empty() const
+{
+	return (count == 0);
+}
+
+size_t CompactFilament::size() const
+{
+	return count;
+}
+
+double CompactFilament::getDiameter() const
+{
+	return diameter;
+}
+
+CartesianCoordinate CompactFilament::getLocation(size_t i) const
+{
+	assert(i < count);
+	return anchor + direction * (i * diameter);
+}
+
+const char* CompactFilament::getState(size_t i) const
+{
+	return getActin(i).getState();
+}
+
+const char* CompactFilament::getBoundState(size_t i) const
+{
+	return getActin(i).getBoundState();
+}
+
+Actin CompactFilament::getActin(size_t i) const
+{
+	const Run& r = getRun(i);
+	Actin actin("inactive", diameter, getLocation(i), false);
+	actin.Molecule::setState(r.state);
+	actin.bstate = r.bound_state;
+	return actin;
+}
+
+Actin CompactFilament::front() const
+{
+	return getActin(0);
+}
+
+Actin CompactFilament::back() const
+{
+	assert(count > 0);
+	return getActin(count - 1);
+}
+
+CompactFilament CompactFilament::split(size_t k)
+{
+	assert(k <= count);
+	CompactFilament distal;
+	distal.anchor = (k < count ? getLocation(k) : anchor);
+	distal.direction = direction;
+	distal.diameter = diameter;
+	distal.count = count - k;
+	// Find the first run which is not entirely kept.
+	size_t pos = 0;
+	std::vector<Run>::iterator it = runs.begin();
+	while(it != runs.end() && pos + it->length <= k)
+	{
+		pos += it->length;
+		++it;
+	}
+	if(it != runs.end() && pos < k)
+	{
+		// The run containing the k-th monomer is shared by both parts.
+		Run r = *it;
+		r.length -= static_cast<std::uint32_t>(k - pos);
+		it->length = static_cast<std::uint32_t>(k - pos);
+		distal.runs.push_back(r);
+		++it;
+	}
+	distal.runs.insert(distal.runs.end(), it, runs.end());
+	runs.erase(it, runs.end());
+	count = k;
+	return distal;
+}
+
+void CompactFilament::age(double period, double hydrolysis_rate, double release_rate, std::mt19937& engine)
+{
+	if(count == 0 || period <= 0) return;
+	size_t n_atp = countState(1);
+	size_t n_adpi = countState(3);
+	size_t n_adp = countState(2);
+	/// Each monomer follows ATP -> ADP-Pi -> ADP independently with
+	/// the rate constants k1 and k2. After a period t, an ATP monomer
+	/// is still ATP with the probability exp(-k1*t), and is ADP-Pi with
+	/// the probability k1/(k2-k1)*(exp(-k1*t)-exp(-k2*t)). An ADP-Pi
+	/// monomer is still ADP-Pi with the probability exp(-k2*t).
+	double atp_stay = simulation::math::exp(-hydrolysis_rate * period);
+	double adpi_stay = simulation::math::exp(-release_rate * period);
+	double atp_to_adpi;
+	if(std::fabs(release_rate - hydrolysis_rate) > 1e-12) atp_to_adpi = hydrolysis_rate / (release_rate - hydrolysis_rate) * (atp_stay - adpi_stay);
+	else atp_to_adpi = hydrolysis_rate * period * atp_stay;
+	size_t hydrolyzed = 0, released = 0, hydrolyzed_released = 0;
+	if(n_atp > 0 && atp_stay < 1)
+	{
+		std::binomial_distribution<size_t> hydrolysis(n_atp, 1 - atp_stay);
+		hydrolyzed = hydrolysis(engine);
+		if(hydrolyzed > 0)
+		{
+			// Among the hydrolyzed monomers, sample those which have
+			// released Pi as well.
+			double p = 1 - atp_to_adpi / (1 - atp_stay);
+			if(p > 0)
+			{
+				std::binomial_distribution<size_t> release(hydrolyzed, p < 1 ? p : 1);
+				hydrolyzed_released = release(engine);
+			}
+		}
+	}
+	if(n_adpi > 0 && adpi_stay < 1)
+	{
+		std::binomial_distribution<size_t> release(n_adpi, 1 - adpi_stay);
+		released = release(engine);
+	}
+	n_adp += released + hydrolyzed_released;
+	n_adpi = n_adpi - released + hydrolyzed - hydrolyzed_released;
+	setNucleotideBoundaries(n_adp, n_adpi);
+}
+
+CompactFilament::const_iterator CompactFilament::begin() const
+{
+	return const_iterator(this, 0);
+}
+
+CompactFilament::const_iterator CompactFilament::end() const
+{
+	return const_iterator(this, count);
+}
+
+}
@@ -1,6 +1,7 @@
 #include <cfloat>
 #include <cmath>
 #include <Coordinate.hpp>
+#include <mathKernels.hpp>
 
 namespace motility
 {
@@ -99,12 +100,12 @@ const CartesianCoordinate& CartesianCoordinate::operator+() const
 	return *this;
 }
 
-const CartesianCoordinate CartesianCoordinate::operator-() const
+CartesianCoordinate CartesianCoordinate::operator-() const
 {
 	return CartesianCoordinate(-x, -y, -z);
 }
 
-const CartesianCoordinate CartesianCoordinate::operator+(const CartesianCoordinate& cc) const
+CartesianCoordinate CartesianCoordinate::operator+(const CartesianCoordinate& cc) const
 {
 	double xx = x + cc.x;
 	double yy = y + cc.y;
@@ -115,7 +116,7 @@ const CartesianCoordinate CartesianCoordinate::operator+(const CartesianCoordina
 	return CartesianCoordinate(xx, yy, zz);
 }
 
-const CartesianCoordinate CartesianCoordinate::operator-(const CartesianCoordinate& cc) const
+CartesianCoordinate CartesianCoordinate::operator-(const CartesianCoordinate& cc) const
 {
 	double xx = x - cc.x;
 	double yy = y - cc.y;
@@ -150,7 +151,7 @@ CartesianCoordinate& CartesianCoordinate::operator-=(const CartesianCoordinate&
 	return *this;
 }
 
-const CartesianCoordinate CartesianCoordinate::operator*(double c) const
+CartesianCoordinate CartesianCoordinate::operator*(double c) const
 {
 	double xx = x * c;
 	double yy = y * c;
@@ -161,7 +162,7 @@ const CartesianCoordinate CartesianCoordinate::operator*(double c) const
 	return CartesianCoordinate(xx, yy, zz);
 }
 
-const CartesianCoordinate CartesianCoordinate::operator/(double c) const
+CartesianCoordinate CartesianCoordinate::operator/(double c) const
 {
 	double xx = x / c;
 	double yy = y / c;
@@ -264,9 +265,12 @@ SphericalCoordinate::SphericalCoordinate(const CylindricalCoordinate& cc)
 
 const CartesianCoordinate SphericalCoordinate::toCartesianCoordinate() const
 {
-	double x = rou * std::cos(theta) * std::sin(phi);
-	double y = rou * std::sin(theta) * std::sin(phi);
-	double z = rou * std::cos(phi);
+	double sin_theta, cos_theta, sin_phi, cos_phi;
+	simulation::math::sincos(theta, sin_theta, cos_theta);
+	simulation::math::sincos(phi, sin_phi, cos_phi);
+	double x = rou * cos_theta * sin_phi;
+	double y = rou * sin_theta * sin_phi;
+	double z = rou * cos_phi;
 	if(std::fabs(x) < DBL_EPSILON) x = 0;
 	if(std::fabs(y) < DBL_EPSILON) y = 0;
 	if(std::fabs(z) < DBL_EPSILON) z = 0;
@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <DiscreteEvent.hpp>
+#include <mathKernels.hpp>
 #include <constants.hpp>
 
 namespace simulation
@@ -24,7 +25,7 @@ double DiscreteEvent::compute_period()
 	/// Sampling function: t = -ln(u) / r, where u is a random
 	/// number uniformly distributed between 0 and 1.
 	double u = static_cast<double>(::random()) / RAND_MAX;
-	return (-std::log(u) / rate);
+	return (-math::log(u) / rate);
 }
 
 double DiscreteEvent::get_period()
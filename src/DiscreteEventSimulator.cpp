@@ -1,5 +1,6 @@
 #include <constants.hpp>
 #include <DiscreteEventSimulator.hpp>
+#include <MemoryArena.hpp>
 
 namespace simulation
 {
@@ -33,32 +34,13 @@ size_t DiscreteEventSimulator::size() const
 	return events.size();
 }
 
-void DiscreteEventSimulator::bubble_sort(DiscreteEvent_iterators& events)
+void DiscreteEventSimulator::merge_sort(DiscreteEvent_iterators& events)
 {
-	if(events.size() > 1)
-	{
-		DiscreteEvent_iterator_iterator event_ptr_ptr = ++events.begin();
-		while(event_ptr_ptr != events.end())
-		{
-			DiscreteEvent_iterator_iterator event_begin_search_ptr_ptr = event_ptr_ptr;
-			--event_begin_search_ptr_ptr;
-			DiscreteEvent_iterator_iterator event_insert_ptr_ptr = event_begin_search_ptr_ptr;
-			while(event_insert_ptr_ptr != events.end() && ***event_ptr_ptr < ***event_insert_ptr_ptr) --event_insert_ptr_ptr;
-			if(event_insert_ptr_ptr != event_begin_search_ptr_ptr)
-			{
-				++event_insert_ptr_ptr;
-				events.insert(event_insert_ptr_ptr, *event_ptr_ptr);
-				// Update the event at the new position.
-				DiscreteEvent_iterator_iterator event_new_ptr_ptr = event_insert_ptr_ptr;
-				--event_new_ptr_ptr;
-				(**event_new_ptr_ptr)->sorted_event = event_new_ptr_ptr;
-				// Remove the event at the old position.
-				DiscreteEvent_iterator_iterator event_old_ptr_ptr = event_ptr_ptr++;
-				events.erase(event_old_ptr_ptr);
-			}
-			else ++event_ptr_ptr;
-		}
-	}
+	// The list is merge sorted by relinking its nodes, which is stable,
+	// so that the events with equal periods keep their relative order.
+	events.sort([](DiscreteEvent_iterator event_ptr1, DiscreteEvent_iterator event_ptr2) { return **event_ptr1 < **event_ptr2; });
+	// Update the positions of all events at one pass.
+	for(DiscreteEvent_iterator_iterator event_ptr_ptr = events.begin(); event_ptr_ptr != events.end(); ++event_ptr_ptr) (**event_ptr_ptr)->sorted_event = event_ptr_ptr;
 }
 
 void DiscreteEventSimulator::step_record()
@@ -75,7 +57,7 @@ void DiscreteEventSimulator::initialize()
 {
 	EventSimulator::initialize();
 	// Initially sort the sorted event list.
-	bubble_sort(sorted_events);
+	merge_sort(sorted_events);
 	// Reset the state of all events.
 	set_event_state(false);
 }
@@ -162,9 +144,11 @@ double DiscreteEventSimulator::update()
 		if(n_event < 2) (*exec_event_ptr)->state = false;
 		else
 		{
-			// Filter out the changed events.
-			DiscreteEvent_iterator_iterators changed_event_ptr_ptrs;
-			DiscreteEvent_iterator_iterators unchanged_event_ptr_ptrs;
+			// Filter out the changed events into temporary lists of the
+			// scratch arena.
+			std::pmr::memory_resource* scratch = MemoryArena::instance().scratch();
+			DiscreteEvent_iterator_iterators changed_event_ptr_ptrs(scratch);
+			DiscreteEvent_iterator_iterators unchanged_event_ptr_ptrs(scratch);
 			for(DiscreteEvent_iterator_iterator event_ptr_ptr = sorted_events.begin(); event_ptr_ptr != sorted_events.end(); ++event_ptr_ptr)
 			{
 				if((**event_ptr_ptr)->get_state()) changed_event_ptr_ptrs.push_back(event_ptr_ptr);
@@ -204,14 +188,17 @@ double DiscreteEventSimulator::update()
 			}
 			else
 			{
-				// If all events are changed, then use bubble sorting algorithm
+				// If all events are changed, then use merge sorting algorithm
 				// to sort all events at one time.
-				bubble_sort(sorted_events);
+				merge_sort(sorted_events);
 				// Reset the state of all events to false.
 				set_event_state(false);
 			}
 		}
 	}
+	// All temporary lists of this step have been destroyed, so the
+	// scratch arena is released as a whole.
+	MemoryArena::instance().releaseScratch();
 	// Return the minimum waiting period.
 	return minimum_waiting_period;
 }
@@ -302,7 +289,7 @@ void DiscreteEventSimulator::modify(DiscreteEvent_iterator event_ptr)
 {
 	// Modify all other affected events.
 	self_modify_flag = false;
-	DiscreteEvent_iterators filtered_events;
+	DiscreteEvent_iterators filtered_events(MemoryArena::instance().scratch());
 	DiscreteEvent_iterators& modified_events = (*event_ptr)->modified_events;
 	for(DiscreteEvent_iterator_iterator event_ptr_ptr = modified_events.begin(); event_ptr_ptr != modified_events.end(); ++event_ptr_ptr)
 	{
@@ -376,7 +363,7 @@ void DiscreteEventSimulator::destroy(DiscreteEvent_iterator event_ptr)
 {
 	// Destroy all other affected events except for this event itself.
 	self_destroy_flag = false;
-	DiscreteEvent_iterators filtered_events;
+	DiscreteEvent_iterators filtered_events(MemoryArena::instance().scratch());
 	DiscreteEvent_iterators& destroyed_events = (*event_ptr)->destroyed_events;
 	for(DiscreteEvent_iterator_iterator event_ptr_ptr = destroyed_events.begin(); event_ptr_ptr != destroyed_events.end(); ++event_ptr_ptr)
 	{
@@ -480,6 +467,17 @@ void DiscreteEventSimulator::remove_connection(DiscreteEvent_iterator event_ptr)
 
 // Trigger, connect and synchronize event.
 
+void DiscreteEventSimulator::refresh_events()
+{
+	for(DiscreteEvent_iterator event_ptr = events.begin(); event_ptr != events.end(); ++event_ptr)
+	{
+		(*event_ptr)->update_rate();
+		(*event_ptr)->update_period();
+	}
+	merge_sort(sorted_events);
+	set_event_state(false);
+}
+
 void DiscreteEventSimulator::trigger(DiscreteEvent_iterator event_ptr)
 {
 	(*event_ptr)->action();
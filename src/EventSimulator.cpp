@@ -57,6 +57,8 @@ void EventSimulator::time_record() {}
 
 void EventSimulator::step_record() {}
 
+void EventSimulator::integrate() {}
+
 void EventSimulator::initialize() {}
 
 void EventSimulator::finalize()
@@ -83,6 +85,7 @@ void EventSimulator::run()
 			status = 1;
 			break;
 		}
+		integrate();
 		record();
 	}
 	finalize();
@@ -0,0 +1,201 @@
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <FacetGrid.hpp>
+#include <constants.hpp>
+
+namespace motility
+{
+
+FacetGrid::FacetGrid()
+{
+	cell_size = 0;
+	query_stamp = 0;
+}
+
+bool FacetGrid::isBuilt() const
+{
+	return (cell_size > 0);
+}
+
+double FacetGrid::getCellSize() const
+{
+	return cell_size;
+}
+
+long FacetGrid::getCellIndex(double x) const
+{
+	return static_cast<long>(std::floor(x / cell_size));
+}
+
+FacetGrid::CellKey FacetGrid::getCellKey(long i, long j, long k) const
+{
+	// Each cell index is biased into 21 bits, which covers far more
+	// cells than the simulation space requires.
+	const long bias = 1L << 20;
+	const CellKey mask = (static_cast<CellKey>(1) << 21) - 1;
+	CellKey key = (static_cast<CellKey>(i + bias) & mask) << 42;
+	key |= (static_cast<CellKey>(j + bias) & mask) << 21;
+	key |= (static_cast<CellKey>(k + bias) & mask);
+	return key;
+}
+
+void FacetGrid::computeCellRange(FacetHandle fh, long* range) const
+{
+	CartesianCoordinate locations[3];
+	for(size_t i = 0; i < 3; ++i) locations[i] = fh->getEdges()[i]->getVertex()->getLocation();
+	double lower[3] = {locations[0].x, locations[0].y, locations[0].z};
+	double upper[3] = {locations[0].x, locations[0].y, locations[0].z};
+	for(size_t i = 1; i < 3; ++i)
+	{
+		double coords[3] = {locations[i].x, locations[i].y, locations[i].z};
+		for(size_t j = 0; j < 3; ++j)
+		{
+			lower[j] = std::min(lower[j], coords[j]);
+			upper[j] = std::max(upper[j], coords[j]);
+		}
+	}
+	for(size_t j = 0; j < 3; ++j)
+	{
+		range[j] = getCellIndex(lower[j]);
+		range[j + 3] = getCellIndex(upper[j]);
+	}
+}
+
+void FacetGrid::rebuild(Facets& facets, double size)
+{
+	assert(size > 0);
+	cells.clear();
+	cell_size = size;
+	for(FacetHandle fh = facets.begin(); fh != facets.end(); ++fh)
+	{
+		fh->grid_flag = false;
+		insert(fh);
+	}
+}
+
+void FacetGrid::insert(FacetHandle fh)
+{
+	if(!isBuilt()) return;
+	long* range = fh->grid_range;
+	computeCellRange(fh, range);
+	for(long i = range[0]; i <= range[3]; ++i)
+	{
+		for(long j = range[1]; j <= range[4]; ++j)
+		{
+			for(long k = range[2]; k <= range[5]; ++k) cells[getCellKey(i, j, k)].push_back(fh);
+		}
+	}
+	fh->grid_flag = true;
+}
+
+void FacetGrid::remove(FacetHandle fh)
+{
+	if(!isBuilt() || !fh->grid_flag) return;
+	long* range = fh->grid_range;
+	for(long i = range[0]; i <= range[3]; ++i)
+	{
+		for(long j = range[1]; j <= range[4]; ++j)
+		{
+			for(long k = range[2]; k <= range[5]; ++k)
+			{
+				std::unordered_map<CellKey, CellFacets>::iterator cit = cells.find(getCellKey(i, j, k));
+				if(cit == cells.end()) continue;
+				CellFacets& cell_facets = cit->second;
+				CellFacets::iterator fit = std::find(cell_facets.begin(), cell_facets.end(), fh);
+				if(fit != cell_facets.end())
+				{
+					*fit = cell_facets.back();
+					cell_facets.pop_back();
+				}
+				if(cell_facets.empty()) cells.erase(cit);
+			}
+		}
+	}
+	fh->grid_flag = false;
+}
+
+void FacetGrid::update(FacetHandle fh)
+{
+	if(!isBuilt()) return;
+	long range[6];
+	computeCellRange(fh, range);
+	if(fh->grid_flag && std::equal(range, range + 6, fh->grid_range)) return;
+	remove(fh);
+	insert(fh);
+}
+
+void FacetGrid::collectCellFacets(long i, long j, long k, FacetHandles& candidates) const
+{
+	std::unordered_map<CellKey, CellFacets>::const_iterator cit = cells.find(getCellKey(i, j, k));
+	if(cit == cells.end()) return;
+	for(CellFacets::const_iterator fit = cit->second.begin(); fit != cit->second.end(); ++fit)
+	{
+		FacetHandle fh = *fit;
+		if(fh->grid_stamp != query_stamp)
+		{
+			fh->grid_stamp = query_stamp;
+			candidates.push_back(fh);
+		}
+	}
+}
+
+FacetHandles FacetGrid::getCandidateFacetHandles(Line& l) const
+{
+	///
+	/// The cells pierced by the line segment are visited in order by
+	/// the 3D digital differential analyzer of Amanatides and Woo, so
+	/// that the cost is proportional to the length of the segment in
+	/// units of cell size.
+	///
+	FacetHandles candidates;
+	if(!isBuilt()) return candidates;
+	++query_stamp;
+	const CartesianCoordinate& b = l.getBegin();
+	const CartesianCoordinate& e = l.getEnd();
+	double begin[3] = {b.x, b.y, b.z};
+	double direction[3] = {e.x - b.x, e.y - b.y, e.z - b.z};
+	long index[3], end_index[3], step[3];
+	double t_max[3], t_delta[3];
+	size_t n_step = 1;
+	for(size_t i = 0; i < 3; ++i)
+	{
+		index[i] = getCellIndex(begin[i]);
+		end_index[i] = getCellIndex(begin[i] + direction[i]);
+		n_step += std::labs(end_index[i] - index[i]);
+		if(direction[i] > 0)
+		{
+			step[i] = 1;
+			t_max[i] = ((index[i] + 1) * cell_size - begin[i]) / direction[i];
+			t_delta[i] = cell_size / direction[i];
+		}
+		else if(direction[i] < 0)
+		{
+			step[i] = -1;
+			t_max[i] = (index[i] * cell_size - begin[i]) / direction[i];
+			t_delta[i] = -cell_size / direction[i];
+		}
+		else
+		{
+			step[i] = 0;
+			t_max[i] = DBL_INF_POSITIVE;
+			t_delta[i] = DBL_INF_POSITIVE;
+		}
+	}
+	// The number of visited cells is bounded by the Manhattan distance
+	// between the end cells, which guards against rounding at the cell
+	// boundaries.
+	for(size_t n = 0; n < n_step; ++n)
+	{
+		collectCellFacets(index[0], index[1], index[2], candidates);
+		size_t axis = 0;
+		if(t_max[1] < t_max[axis]) axis = 1;
+		if(t_max[2] < t_max[axis]) axis = 2;
+		if(t_max[axis] > 1) break;
+		index[axis] += step[axis];
+		t_max[axis] += t_delta[axis];
+	}
+	return candidates;
+}
+
+}
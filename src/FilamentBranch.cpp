@@ -1,4 +1,6 @@
 #include <cassert>
+#include <cmath>
+#include <utility>
 #include <FilamentBranch.hpp>
 #include <BranchTree.hpp>
 #include <VertexEdgeFacet.hpp>
@@ -11,132 +13,142 @@ namespace motility
 
 FilamentBranch::FilamentBranch()
 {
-	vertex = vertex_handle_null;
-	membrane_attachment = false;
+	id = FilamentStateTable::instance().acquire();
+	getState().vertex = vertex_handle_null;
 	membrane_linkage = false;
-	arp23_handle = nullptr;
-	cap_handle = nullptr;
 	tree_handle = branch_tree_handle_null;
 	parent_handle = filament_branch_handle_null;
+	parent_id = filament_handle_null;
 	nth_child_of_parent = 0;
 	branching_angle = 0;
+	arp23_binding_actins = 0;
+	last_child_location = 0;
 	initial_length = 0;
+	nucleotide_time = 0;
 	child_branching_flag = false;
 	child_branch_facet = facet_handle_null;
 	virtual_tail_end = false;
 	virtual_tail_end_diameter = 0;
 }
 
-FilamentBranch::FilamentBranch(const ARP23& arp23, const Actin& actin, const Orientation& ot)
+FilamentBranch::FilamentBranch(const ARP23& a, const Actin& actin, const Orientation& ot) : arp23(a)
 {
-	initializeMemory(arp23);
-	arp23_handle->immobilize();
+	id = FilamentStateTable::instance().acquire();
+	arp23->immobilize();
 	orient = ot;
-	vertex = vertex_handle_null;
-	membrane_attachment = false;
+	// The orientation is converted into a unit vector only once.
+	Vector direction(1, orient);
+	getState().direction = GeometryPrecision::store(Vec3d(direction.getX(), direction.getY(), direction.getZ()));
+	getState().vertex = vertex_handle_null;
 	membrane_linkage = false;
 	tree_handle = branch_tree_handle_null;
 	parent_handle = filament_branch_handle_null;
+	parent_id = filament_handle_null;
 	nth_child_of_parent = 0;
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double angle = strtod(param_table[std::string("branching_angle")]);
+	double angle = strtod(ParameterTable::lookup("branching_angle"));
 	branching_angle = angle * M_PI / 180;
+	arp23_binding_actins = strtoul(ParameterTable::lookup("arp23_binding_actins"));
+	last_child_location = 0;
 	virtual_tail_end = false;
 	virtual_tail_end_diameter = 0;
+	updateEndLocations();
 	// One Arp23 molecule and 'branching_actin_quantity' number of
 	// actin molecules are needed to create a new actin filament.
-	size_t branching_actin_quantity = strtoul(param_table[std::string("branching_actin_quantity")]);
-	for(size_t i = 0; i < branching_actin_quantity; ++i) assert(addActin(actin));
+	size_t branching_actin_quantity = strtoul(ParameterTable::lookup("branching_actin_quantity"));
+	for(size_t i = 0; i < branching_actin_quantity; ++i)
+	{
+		[[maybe_unused]] bool action = addActin(actin);
+		assert(action);
+	}
 	initial_length = distance(getHeadEndLocation(), getTailEndLocation());
+	nucleotide_time = 0;
+}
+
+FilamentBranch::FilamentBranch(const FilamentBranch& fb) : filament(fb.filament), membrane_linkage(fb.membrane_linkage), branching_angle(fb.branching_angle), arp23_binding_actins(fb.arp23_binding_actins), orient(fb.orient), arp23(fb.arp23), cap(fb.cap), tree_handle(fb.tree_handle), parent_handle(fb.parent_handle), parent_id(fb.parent_id), nth_child_of_parent(fb.nth_child_of_parent), child_branches(fb.child_branches), child_locations(fb.child_locations), last_child_location(fb.last_child_location), child_branching_flag(fb.child_branching_flag), child_branch_orient(fb.child_branch_orient), child_branch_facet(fb.child_branch_facet), initial_length(fb.initial_length), nucleotide_time(fb.nucleotide_time), virtual_tail_end(fb.virtual_tail_end), virtual_tail_end_location(fb.virtual_tail_end_location), virtual_tail_end_diameter(fb.virtual_tail_end_diameter), reactions(fb.reactions)
+{
+	id = FilamentStateTable::instance().acquire();
+	getState() = fb.getState();
 }
 
-FilamentBranch::FilamentBranch(const FilamentBranch& fb)
+FilamentBranch::FilamentBranch(FilamentBranch&& fb) : filament(std::move(fb.filament)), membrane_linkage(fb.membrane_linkage), branching_angle(fb.branching_angle), arp23_binding_actins(fb.arp23_binding_actins), orient(fb.orient), arp23(std::move(fb.arp23)), cap(std::move(fb.cap)), tree_handle(fb.tree_handle), parent_handle(fb.parent_handle), parent_id(fb.parent_id), nth_child_of_parent(fb.nth_child_of_parent), child_branches(std::move(fb.child_branches)), child_locations(std::move(fb.child_locations)), last_child_location(fb.last_child_location), child_branching_flag(fb.child_branching_flag), child_branch_orient(fb.child_branch_orient), child_branch_facet(fb.child_branch_facet), initial_length(fb.initial_length), nucleotide_time(fb.nucleotide_time), virtual_tail_end(fb.virtual_tail_end), virtual_tail_end_location(fb.virtual_tail_end_location), virtual_tail_end_diameter(fb.virtual_tail_end_diameter), reactions(std::move(fb.reactions))
 {
-	copyMemory(fb);
+	// The moved filament takes over the hot state of the source,
+	// which is left without any id.
+	id = fb.id;
+	fb.id = filament_id_null;
 }
 
 FilamentBranch::~FilamentBranch()
 {
-	clearMemory();
+	if(id != filament_id_null) FilamentStateTable::instance().release(id);
 }
 
-void FilamentBranch::initializeMemory(const ARP23& arp23)
+FilamentState& FilamentBranch::getState() const
 {
-	arp23_handle = new ARP23;
-	*arp23_handle = arp23;
-	cap_handle = nullptr;
+	return FilamentStateTable::instance()[id];
 }
 
-void FilamentBranch::clearMemory()
+size_t FilamentBranch::getId() const
 {
-	if(arp23_handle != nullptr)
-	{
-		delete arp23_handle;
-		arp23_handle = nullptr;
-	}
-	if(cap_handle != nullptr)
-	{
-		delete cap_handle;
-		cap_handle = nullptr;
-	}
+	return id;
+}
+
+FilamentId FilamentBranch::getHandle() const
+{
+	return FilamentStateTable::instance().getFilamentId(id);
+}
+
+CartesianCoordinate FilamentBranch::getLocationOfTheOtherEnd(const CartesianCoordinate& loc, double dist) const
+{
+	return loc + GeometryPrecision::loadCoordinate(getState().direction) * dist;
 }
 
-void FilamentBranch::copyMemory(const FilamentBranch& fb)
+void FilamentBranch::updateEndLocations()
 {
-	if(fb.arp23_handle != nullptr)
+	///
+	/// The locations of both ends are cached because they are
+	/// queried by almost every rate evaluation, while they only
+	/// change when a molecule is added to or removed from this
+	/// filament.
+	///
+	FilamentState& state = getState();
+	if(arp23.has_value()) state.head_end_location = GeometryPrecision::store(arp23->getLocation());
+	else if(!filament.empty()) state.head_end_location = GeometryPrecision::store(filament.getLocation(0));
+	else {}
+	if(cap.has_value())
+	{
+		state.tail_end_diameter = cap->getDiameter();
+		state.tail_end_location = GeometryPrecision::store(getLocationOfTheOtherEnd(cap->getLocation(), cap->getDiameter()));
+	}
+	else if(!filament.empty())
 	{
-		arp23_handle = new ARP23;
-		*arp23_handle = *(fb.arp23_handle);
+		state.tail_end_diameter = filament.getDiameter() / 2;
+		state.tail_end_location = GeometryPrecision::store(getLocationOfTheOtherEnd(filament.getLocation(filament.size() - 1), filament.getDiameter() / 2));
 	}
-	else arp23_handle = nullptr;
-	if(fb.cap_handle != nullptr)
+	else if(arp23.has_value())
 	{
-		cap_handle = new CAP;
-		*cap_handle = *(fb.cap_handle);
+		state.tail_end_diameter = arp23->getDiameter();
+		state.tail_end_location = GeometryPrecision::store(getLocationOfTheOtherEnd(arp23->getLocation(), arp23->getDiameter()));
 	}
-	else cap_handle = nullptr;
-	orient = fb.orient;
-	filament = fb.filament;
-	vertex = fb.vertex;
-	membrane_attachment = fb.membrane_attachment;
-	membrane_linkage = fb.membrane_linkage;
-	tree_handle = fb.tree_handle;
-	parent_handle = fb.parent_handle;
-	nth_child_of_parent = fb.nth_child_of_parent;
-	child_branches = fb.child_branches;
-	child_locations = fb.child_locations;
-	branching_angle = fb.branching_angle;
-	child_branching_flag = fb.child_branching_flag;
-	child_branch_orient = fb.child_branch_orient;
-	child_branch_facet = fb.child_branch_facet;
-	initial_length = fb.initial_length;
-	virtual_tail_end = fb.virtual_tail_end;
-	virtual_tail_end_location = fb.virtual_tail_end_location;
-	virtual_tail_end_diameter = fb.virtual_tail_end_diameter;
-	reactions = fb.reactions;
-}
-
-CartesianCoordinate FilamentBranch::getLocationOfTheOtherEnd(const CartesianCoordinate& loc, double dist, const Orientation& ot) const
-{
-	Line l(loc, Vector(dist, ot));
-	return l.getEnd();
+	else {}
+	state.capped = cap.has_value();
+	state.environment.valid = false;
+	assert(std::isfinite(state.tail_end_location.x) && std::isfinite(state.tail_end_location.y) && std::isfinite(state.tail_end_location.z));
 }
 
 VertexHandle FilamentBranch::getVertex()
 {
-	return vertex;
+	return getState().vertex;
 }
 
 void FilamentBranch::setVertex(VertexHandle vh)
 {
-	vertex = vh;
-	if(vertex != vertex_handle_null) membrane_attachment = true;
-	else membrane_attachment = false;
+	getState().vertex = vh;
 }
 
 bool FilamentBranch::isAttachedToMembrane() const
 {
-	return membrane_attachment;
+	return (getState().vertex != vertex_handle_null);
 }
 
 bool FilamentBranch::isLinkedToMembrane() const
@@ -147,14 +159,12 @@ bool FilamentBranch::isLinkedToMembrane() const
 bool FilamentBranch::addActin(const Actin& actin)
 {
 	bool action;
-	if(cap_handle == nullptr)
+	if(!cap.has_value())
 	{
-		CartesianCoordinate last_tail_end_loc = getTailEndLocation();
-		double last_tail_end_diam = getTailEndDiameter();
+		// The location of the first actin anchors all the others.
+		if(filament.empty()) filament.setAnchor(getLocationOfTheOtherEnd(getTailEndLocation(), getTailEndDiameter()), getDirection());
 		filament.push_back(actin);
-		Actin& a = filament.back();
-		a.setLocation(getLocationOfTheOtherEnd(last_tail_end_loc, last_tail_end_diam, orient));
-		a.immobilize();
+		updateEndLocations();
 		action = true;
 	}
 	else action = false;
@@ -167,21 +177,21 @@ bool FilamentBranch::removeActin()
 	if(!filament.empty())
 	{
 		filament.pop_back();
-		if(cap_handle != nullptr)
+		if(cap.has_value())
 		{
 			if(!filament.empty())
 			{
-				Actin& tail_end_actin = filament.back();
-				cap_handle->setLocation(getLocationOfTheOtherEnd(tail_end_actin.getLocation(), tail_end_actin.getDiameter() / 2, orient));
+				cap->setLocation(getLocationOfTheOtherEnd(filament.getLocation(filament.size() - 1), filament.getDiameter() / 2));
 			}
 			else
 			{
-				assert(arp23_handle != nullptr);
-				cap_handle->setLocation(getLocationOfTheOtherEnd(arp23_handle->getLocation(), arp23_handle->getDiameter(), orient));
+				assert(arp23.has_value());
+				cap->setLocation(getLocationOfTheOtherEnd(arp23->getLocation(), arp23->getDiameter()));
 			}
 			action = true;
 		}
 		else action = false;
+		updateEndLocations();
 	}
 	else action = false;
 	return action;
@@ -195,7 +205,7 @@ bool FilamentBranch::perturbTailEndLocation(const Molecule& mol)
 	if(!virtual_tail_end)
 	{
 		virtual_tail_end_diameter = mol.getDiameter();
-		virtual_tail_end_location = getLocationOfTheOtherEnd(getTailEndLocation(), virtual_tail_end_diameter, orient);
+		virtual_tail_end_location = getLocationOfTheOtherEnd(GeometryPrecision::loadCoordinate(getState().tail_end_location), virtual_tail_end_diameter);
 		virtual_tail_end = true;
 		action = true;
 	}
@@ -218,24 +228,23 @@ bool FilamentBranch::restoreTailEndLocation()
 	return action;
 }
 
-bool FilamentBranch::addCap(const CAP& cap)
+bool FilamentBranch::addCap(const CAP& c)
 {
 	bool action;
-	if(cap_handle == nullptr)
+	if(!cap.has_value())
 	{
-		cap_handle = new CAP;
-		*cap_handle = cap;
+		cap.emplace(c);
 		if(filament.empty())
 		{
-			assert(arp23_handle != nullptr);
-			cap_handle->setLocation(getLocationOfTheOtherEnd(arp23_handle->getLocation(), arp23_handle->getDiameter(), orient));
+			assert(arp23.has_value());
+			cap->setLocation(getLocationOfTheOtherEnd(arp23->getLocation(), arp23->getDiameter()));
 		}
 		else
 		{
-			Actin& tail_end_actin = filament.back();
-			cap_handle->setLocation(getLocationOfTheOtherEnd(tail_end_actin.getLocation(), tail_end_actin.getDiameter() / 2, orient));
+			cap->setLocation(getLocationOfTheOtherEnd(filament.getLocation(filament.size() - 1), filament.getDiameter() / 2));
 		}
-		cap_handle->immobilize();
+		cap->immobilize();
+		updateEndLocations();
 		action = true;
 	}
 	else action = false;
@@ -245,10 +254,10 @@ bool FilamentBranch::addCap(const CAP& cap)
 bool FilamentBranch::removeCap()
 {
 	bool action;
-	if(cap_handle != nullptr)
+	if(cap.has_value())
 	{
-		delete cap_handle;
-		cap_handle = nullptr;
+		cap.reset();
+		updateEndLocations();
 		action = true;
 	}
 	else action = false;
@@ -258,51 +267,94 @@ bool FilamentBranch::removeCap()
 bool FilamentBranch::removeArp23()
 {
 	bool action;
-	if(arp23_handle != nullptr)
+	if(arp23.has_value())
 	{
-		delete arp23_handle;
-		arp23_handle = nullptr;
+		arp23.reset();
+		updateEndLocations();
 		action = true;
 	}
 	else action = false;
 	return action;
 }
 
+FilamentBranch FilamentBranch::sever(size_t k)
+{
+	assert(k > 0 && k < filament.size());
+	FilamentBranch distal;
+	distal.filament = filament.split(k);
+	distal.orient = orient;
+	distal.getState().direction = getState().direction;
+	distal.branching_angle = branching_angle;
+	distal.arp23_binding_actins = arp23_binding_actins;
+	distal.cap = std::move(cap);
+	cap.reset();
+	distal.tree_handle = tree_handle;
+	distal.initial_length = initial_length;
+	distal.nucleotide_time = nucleotide_time;
+	// The child filaments located on the distal part are moved to the
+	// new filament, with their locations counted from its pointed end.
+	FilamentBranchHandleHandle fbhh = child_branches.begin();
+	std::pmr::list<size_t>::iterator lit = child_locations.begin();
+	size_t nth = 0;
+	while(fbhh != child_branches.end())
+	{
+		if(*lit >= k)
+		{
+			(*fbhh)->setNthChildOfParent(distal.child_branches.size());
+			distal.child_branches.push_back(*fbhh);
+			distal.child_locations.push_back(*lit - k);
+			fbhh = child_branches.erase(fbhh);
+			lit = child_locations.erase(lit);
+		}
+		else
+		{
+			(*fbhh)->setNthChildOfParent(nth++);
+			++fbhh;
+			++lit;
+		}
+	}
+	if(!distal.child_locations.empty()) distal.last_child_location = distal.child_locations.back();
+	if(last_child_location >= k) last_child_location = (child_locations.empty() ? 0 : child_locations.back());
+	updateEndLocations();
+	distal.updateEndLocations();
+	return distal;
+}
+
 bool FilamentBranch::isArp23ed() const
 {
-	return ((arp23_handle != nullptr) ? true : false);
+	return arp23.has_value();
 }
 
 bool FilamentBranch::isCapped() const
 {
-	return ((cap_handle != nullptr) ? true : false);
+	return getState().capped;
 }
 
 ARP23* FilamentBranch::getArp23Pointer()
 {
-	return arp23_handle;
+	return (arp23.has_value() ? &(*arp23) : nullptr);
 }
 
 CartesianCoordinate FilamentBranch::getArp23Location() const
 {
-	assert(arp23_handle != nullptr);
-	return arp23_handle->getLocation();
+	assert(arp23.has_value());
+	return arp23->getLocation();
 }
 
 CAP* FilamentBranch::getCapPointer()
 {
-	return cap_handle;
+	return (cap.has_value() ? &(*cap) : nullptr);
 }
 
 CartesianCoordinate FilamentBranch::getCapLocation() const
 {
-	assert(cap_handle != nullptr);
-	return cap_handle->getLocation();
+	assert(cap.has_value());
+	return cap->getLocation();
 }
 
 bool FilamentBranch::isEmpty() const
 {
-	return (!arp23_handle && !cap_handle && filament.empty());
+	return (!arp23.has_value() && !cap.has_value() && filament.empty());
 }
 
 bool FilamentBranch::isFilamentEmpty() const
@@ -310,7 +362,7 @@ bool FilamentBranch::isFilamentEmpty() const
 	return filament.empty();
 }
 
-Actins& FilamentBranch::getFilament()
+const CompactFilament& FilamentBranch::getFilament() const
 {
 	return filament;
 }
@@ -338,6 +390,13 @@ FilamentBranchHandle FilamentBranch::getParentHandle()
 void FilamentBranch::setParentHandle(FilamentBranchHandle ph)
 {
 	parent_handle = ph;
+	if(ph != filament_branch_handle_null) parent_id = ph->getHandle();
+	else parent_id = filament_handle_null;
+}
+
+bool FilamentBranch::hasParent() const
+{
+	return FilamentStateTable::instance().isValid(parent_id);
 }
 
 size_t FilamentBranch::getNthChildOfParent()
@@ -365,41 +424,50 @@ void FilamentBranch::addChildHandle(FilamentBranchHandle childHandle)
 	child_branches.push_back(childHandle);
 }
 
-std::list<size_t>& FilamentBranch::getChildLocations()
+void FilamentBranch::removeChildHandle(FilamentBranchHandle childHandle)
+{
+	// The child filaments and their locations are stored in the same
+	// order, so both are advanced together.
+	FilamentBranchHandleHandle fbhh = child_branches.begin();
+	std::pmr::list<size_t>::iterator lit = child_locations.begin();
+	while(fbhh != child_branches.end() && *fbhh != childHandle)
+	{
+		++fbhh;
+		++lit;
+	}
+	assert(fbhh != child_branches.end());
+	fbhh = child_branches.erase(fbhh);
+	child_locations.erase(lit);
+	last_child_location = (child_locations.empty() ? 0 : child_locations.back());
+	for(; fbhh != child_branches.end(); ++fbhh) (*fbhh)->setNthChildOfParent((*fbhh)->getNthChildOfParent() - 1);
+}
+
+std::pmr::list<size_t>& FilamentBranch::getChildLocations()
 {
 	return child_locations;
 }
 
 size_t FilamentBranch::getLastChildLocation() const
 {
-	size_t cLoc;
-	if(!child_locations.empty()) cLoc = child_locations.back();
-	else cLoc = 0;
-	return cLoc;
+	return last_child_location;
 }
 
 void FilamentBranch::addChildLocation(size_t childLoc)
 {
 	child_locations.push_back(childLoc);
+	last_child_location = childLoc;
 }
 
 bool FilamentBranch::isMinimalLengthForBranchingReached() const
 {
-	bool isReached;
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	size_t arp23_binding_actins = strtoul(param_table[std::string("arp23_binding_actins")]);
 	size_t minimal_filament_length = arp23_binding_actins + 1;
-	if(filament.size() < minimal_filament_length) isReached = false;
-	else isReached = true;
-	return isReached;
+	return (filament.size() >= minimal_filament_length);
 }
 
 bool FilamentBranch::isBranchingAllowed() const
 {
-	ParameterTable::Table& param_table = ParameterTable::instance();
 	bool branching = true;
-	size_t nChild = child_branches.size();
-	if(nChild == 0)
+	if(child_branches.empty())
 	{
 		// Determine if current actin filament is long enough to
 		// accommodate child branch.
@@ -410,108 +478,47 @@ bool FilamentBranch::isBranchingAllowed() const
 		// Determine if the child branch to be created is far away
 		// enough from previously created neighboring child branch
 		// of current mother filament.
-		size_t arp23_binding_actins = strtoul(param_table[std::string("arp23_binding_actins")]);
-		size_t branching_site_location = filament.size() - arp23_binding_actins / 2 - 1;
-		// 'branching_site_location' is the location of ARP23-binding
-		// site on mother filament. It is counted from the pointed end
-		// of mother filament and it starts from 0.
-		long dist = branching_site_location - getLastChildLocation();
-		assert(dist >= 0);
-		if(static_cast<size_t>(dist) < arp23_binding_actins) branching = false;
+		size_t branching_site_location = getBranchingSiteActinIndex();
+		if(branching_site_location < last_child_location + arp23_binding_actins) branching = false;
 	}
 	return branching;
 }
 
-ActinConstHandle FilamentBranch::getBranchingSiteActinConstHandle() const
+bool FilamentBranch::hasBranchingSiteActin() const
 {
-	ActinConstHandle ah;
-	if(isMinimalLengthForBranchingReached())
-	{
-		ParameterTable::Table& param_table = ParameterTable::instance();
-		size_t arp23_binding_actins = strtoul(param_table[std::string("arp23_binding_actins")]);
-		size_t branching_site_location = arp23_binding_actins / 2 + 1;
-		// 'branching_site_location' is the location of ARP23-binding
-		// site on mother filament. It is counted from the barbed end
-		// of mother filament and it starts from 1.
-		ah = filament.end();
-		for(size_t i = 0; i < branching_site_location; i++) --ah;
-	}
-	else ah = actin_handle_null;
-	return ah;
+	return isMinimalLengthForBranchingReached();
+}
+
+size_t FilamentBranch::getBranchingSiteActinIndex() const
+{
+	// The ARP23-binding site is the (arp23_binding_actins / 2 + 1)-th
+	// actin counted from the barbed end of mother filament starting
+	// from 1, such that an ARP23 molecule binds to 'arp23_binding_actins'
+	// number of polymerized actin monomers on mother filament starting
+	// from filament barbed end immediately.
+	assert(filament.size() > arp23_binding_actins / 2);
+	return filament.size() - arp23_binding_actins / 2 - 1;
 }
 
 CartesianCoordinate FilamentBranch::getBranchingSiteActinLocation() const
 {
-	ActinConstHandle ah = getBranchingSiteActinConstHandle();
-	assert(ah != actin_handle_null);
-	return ah->getLocation();
+	return filament.getLocation(getBranchingSiteActinIndex());
 }
 
 CartesianCoordinate FilamentBranch::getHeadEndLocation() const
 {
-	CartesianCoordinate loc;
-	if(arp23_handle != nullptr)
-	{
-		loc = arp23_handle->getLocation();
-	}
-	else
-	{
-		assert(filament.empty() == false);
-		loc = filament.front().getLocation();
-	}
-	return loc;
+	assert(arp23.has_value() || !filament.empty());
+	return GeometryPrecision::loadCoordinate(getState().head_end_location);
 }
 
 CartesianCoordinate FilamentBranch::getTailEndLocation() const
 {
-	CartesianCoordinate loc;
-	if(!virtual_tail_end)
-	{
-		if(cap_handle != nullptr)
-		{
-			loc = getLocationOfTheOtherEnd(cap_handle->getLocation(), cap_handle->getDiameter(), orient);
-		}
-		else
-		{
-			if(filament.empty())
-			{
-				assert(arp23_handle != nullptr);
-				loc = getLocationOfTheOtherEnd(arp23_handle->getLocation(), arp23_handle->getDiameter(), orient);
-			}
-			else
-			{
-				const Actin& actin = filament.back();
-				loc = getLocationOfTheOtherEnd(actin.getLocation(), actin.getDiameter() / 2, orient);
-			}
-		}
-		assert(finite(loc.x) && finite(loc.y) && finite(loc.z));
-	}
-	else loc = virtual_tail_end_location;
-	return loc;
+	return (virtual_tail_end ? virtual_tail_end_location : GeometryPrecision::loadCoordinate(getState().tail_end_location));
 }
 
 double FilamentBranch::getTailEndDiameter() const
 {
-	double diam;
-	if(!virtual_tail_end)
-	{
-		if(cap_handle != nullptr) diam = cap_handle->getDiameter();
-		else
-		{
-			if(filament.empty())
-			{
-				assert(arp23_handle != nullptr);
-				diam = arp23_handle->getDiameter();
-			}
-			else
-			{
-				const Actin& actin = filament.back();
-				diam = actin.getDiameter() / 2;
-			}
-		}
-	}
-	else diam = virtual_tail_end_diameter;
-	return diam;
+	return (virtual_tail_end ? virtual_tail_end_diameter : getState().tail_end_diameter);
 }
 
 const Orientation& FilamentBranch::getOrient() const
@@ -519,6 +526,12 @@ const Orientation& FilamentBranch::getOrient() const
 	return orient;
 }
 
+Vector FilamentBranch::getDirection() const
+{
+	const FilamentState::stored_vector& direction = getState().direction;
+	return Vector(direction.x, direction.y, direction.z);
+}
+
 bool FilamentBranch::getChildBranchingFlag() const
 {
 	return child_branching_flag;
@@ -554,6 +567,23 @@ double FilamentBranch::getInitialLength() const
 	return initial_length;
 }
 
+double FilamentBranch::getNucleotideTime() const
+{
+	return nucleotide_time;
+}
+
+void FilamentBranch::setNucleotideTime(double time)
+{
+	nucleotide_time = time;
+}
+
+void FilamentBranch::ageNucleotides(double time, double hydrolysis_rate, double release_rate, std::mt19937& engine)
+{
+	if(time <= nucleotide_time) return;
+	filament.age(time - nucleotide_time, hydrolysis_rate, release_rate, engine);
+	nucleotide_time = time;
+}
+
 simulation::DiscreteEvent_iterators& FilamentBranch::getReactions()
 {
 	return reactions;
@@ -569,12 +599,47 @@ void FilamentBranch::removeReaction(simulation::DiscreteEvent_iterator reac)
 	reactions.remove(reac);
 }
 
+
 FilamentBranch& FilamentBranch::operator=(const FilamentBranch& fb)
 {
 	if(this != &fb)
 	{
-		clearMemory();
-		copyMemory(fb);
+		FilamentBranch copy(fb);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+FilamentBranch& FilamentBranch::operator=(FilamentBranch&& fb)
+{
+	if(this != &fb)
+	{
+		if(id != filament_id_null) FilamentStateTable::instance().release(id);
+		id = fb.id;
+		fb.id = filament_id_null;
+		filament = std::move(fb.filament);
+		membrane_linkage = fb.membrane_linkage;
+		branching_angle = fb.branching_angle;
+		arp23_binding_actins = fb.arp23_binding_actins;
+		orient = fb.orient;
+		arp23 = std::move(fb.arp23);
+		cap = std::move(fb.cap);
+		tree_handle = fb.tree_handle;
+		parent_handle = fb.parent_handle;
+		parent_id = fb.parent_id;
+		nth_child_of_parent = fb.nth_child_of_parent;
+		child_branches = std::move(fb.child_branches);
+		child_locations = std::move(fb.child_locations);
+		last_child_location = fb.last_child_location;
+		child_branching_flag = fb.child_branching_flag;
+		child_branch_orient = fb.child_branch_orient;
+		child_branch_facet = fb.child_branch_facet;
+		initial_length = fb.initial_length;
+		nucleotide_time = fb.nucleotide_time;
+		virtual_tail_end = fb.virtual_tail_end;
+		virtual_tail_end_location = fb.virtual_tail_end_location;
+		virtual_tail_end_diameter = fb.virtual_tail_end_diameter;
+		reactions = std::move(fb.reactions);
 	}
 	return *this;
 }
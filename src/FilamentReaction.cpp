@@ -2,19 +2,21 @@
 #include <FilamentReaction.hpp>
 #include <constants.hpp>
 #include <algorithms.hpp>
+#include <MemoryArena.hpp>
+#include <FlatSet.hpp>
 
 namespace motility
 {
 
-FilamentReaction::FilamentReaction(const std::string& t, FilamentBranchHandle f, MotileCell* c, UniformMolecularDistribution* e) : simulation::DiscreteEvent()
+FilamentReaction::FilamentReaction(const std::string& t, FilamentBranchHandle f, MotileCell* c, bool update_flag) : simulation::DiscreteEvent()
 {
 	type = t;
 	filament = f;
+	filament_id = f->getHandle();
 	cell = c;
-	ecs = e;
 	affected_filaments.clear();
 	// Initiate the rate and period of this filament reactions.
-	update();
+	if(update_flag) update();
 }
 
 FilamentReaction::~FilamentReaction() throw() {}
@@ -29,10 +31,18 @@ FilamentBranchHandle FilamentReaction::getFilament()
 	return filament;
 }
 
+bool FilamentReaction::isFilamentValid() const
+{
+	return FilamentStateTable::instance().isValid(filament_id);
+}
+
 double FilamentReaction::compute_rate()
 {
+	// A reaction whose filament has been removed never occurs until
+	// it is destroyed.
+	if(!isFilamentValid()) return 0;
 	double r;
-	bool outside_flag = isEqual(ecs->getDensity(filament->getTailEndLocation()), 0);
+	bool outside_flag = !cell->isTipInSignal(filament);
 	SWITCH(type)
 	{
 		// If a filament grows out of extracellular signaling region,
@@ -56,6 +66,18 @@ double FilamentReaction::compute_rate()
 			else r = DBL_INF_POSITIVE;
 			break;
 		}
+		// The depolymerization and severing by ADF are independent of
+		// extracellular signal.
+		CASE("SHRINKING")
+		{
+			r = cell->computeFilamentShrinkingRate(filament);
+			break;
+		}
+		CASE("SEVERING")
+		{
+			r = cell->computeFilamentSeveringRate(filament);
+			break;
+		}
 		DEFAULT()
 		{
 			r = DBL_INF_POSITIVE;
@@ -90,6 +112,16 @@ void FilamentReaction::action()
 			affected_vertices = cell->capFilament(filament);
 			break;
 		}
+		CASE("SHRINKING")
+		{
+			affected_vertices = cell->shrinkFilament(filament);
+			break;
+		}
+		CASE("SEVERING")
+		{
+			affected_vertices = cell->severFilament(filament);
+			break;
+		}
 		DEFAULT() {}
 	}
 	SWITCH_END()
@@ -98,15 +130,18 @@ void FilamentReaction::action()
 	// neighboring filaments attached to local surface, it is important
 	// to update the list of affect filaments of this reaction right
 	// after its action is executed.
-	affected_filaments.clear();
+	FilamentSet filament_set(simulation::MemoryArena::instance().scratch());
+	filament_set.reserve(affected_vertices.size() + 1);
 	for(VertexHandleHandle vhh = affected_vertices.begin(); vhh != affected_vertices.end(); ++vhh)
 	{
 		FilamentBranchHandle branch_handle = (*vhh)->getFilament();
-		if(!branch_handle->isCapped()) affected_filaments.push_back(branch_handle);
+		if(!branch_handle->isCapped()) filament_set.insert(branch_handle);
 	}
 	// The action of this reaction also affects the filament that
-	// this reaction is associated with.
-    unique_append<FilamentBranchHandle>(affected_filaments, filament);
+	// this reaction is associated with, unless the filament has
+	// been detached from cell membrane by the action.
+	if(isFilamentValid() && filament->isAttachedToMembrane()) filament_set.insert(filament);
+	affected_filaments.assign(filament_set.begin(), filament_set.end());
 }
 
 }
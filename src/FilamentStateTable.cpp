@@ -0,0 +1,84 @@
+#include <cassert>
+#include <FilamentStateTable.hpp>
+
+namespace motility
+{
+
+FilamentStateTable::FilamentStateTable() {}
+
+FilamentStateTable::~FilamentStateTable() {}
+
+size_t FilamentStateTable::Table::acquire()
+{
+	size_t id;
+	if(!free_ids.empty())
+	{
+		id = free_ids.back();
+		free_ids.pop_back();
+	}
+	else
+	{
+		id = states.size();
+		states.push_back(FilamentState());
+		states[id].generation = 0;
+	}
+	size_t generation = states[id].generation;
+	states[id] = FilamentState();
+	states[id].tail_end_diameter = 0;
+	states[id].capped = false;
+	states[id].environment.valid = false;
+	states[id].active = true;
+	states[id].mark = 0;
+	states[id].generation = generation;
+	return id;
+}
+
+void FilamentStateTable::Table::release(size_t id)
+{
+	assert(id < states.size() && states[id].active);
+	states[id].active = false;
+	++states[id].generation;
+	free_ids.push_back(id);
+}
+
+size_t FilamentStateTable::Table::size() const
+{
+	return states.size();
+}
+
+bool FilamentStateTable::Table::isActive(size_t id) const
+{
+	return (id < states.size() && states[id].active);
+}
+
+FilamentId FilamentStateTable::Table::getFilamentId(size_t id) const
+{
+	assert(isActive(id));
+	FilamentId fid = {id, states[id].generation};
+	return fid;
+}
+
+bool FilamentStateTable::Table::isValid(const FilamentId& fid) const
+{
+	return (isActive(fid.index) && states[fid.index].generation == fid.generation);
+}
+
+FilamentState& FilamentStateTable::Table::operator[](size_t id)
+{
+	assert(id < states.size());
+	return states[id];
+}
+
+const FilamentState& FilamentStateTable::Table::operator[](size_t id) const
+{
+	assert(id < states.size());
+	return states[id];
+}
+
+FilamentStateTable::Table& FilamentStateTable::instance()
+{
+	static FilamentStateTable fst;
+	return fst.table;
+}
+
+}
@@ -9,23 +9,30 @@ Line::Line(const CartesianCoordinate& bp, const CartesianCoordinate& ep)
 {
 	begin = bp;
 	end = ep;
-	vector = Vector(begin, end);
+	vector = end.toVec3() - begin.toVec3();
 }
 
 Line::Line(const CartesianCoordinate* ps)
 {
 	begin = ps[0];
 	end = ps[1];
-	vector = Vector(begin, end);
+	vector = end.toVec3() - begin.toVec3();
 }
 
 Line::Line(const CartesianCoordinate& bp, const Vector& v)
 {
 	begin = bp;
-	vector = v;
+	vector = v.toVec3();
 	end = bp + v;
 }
 
+Line::Line(const CartesianCoordinate& bp, const Vec3d& v)
+{
+	begin = bp;
+	vector = v;
+	end = bp.toVec3() + v;
+}
+
 const CartesianCoordinate& Line::getBegin() const
 {
 	return begin;
@@ -36,39 +43,39 @@ const CartesianCoordinate& Line::getEnd() const
 	return end;
 }
 
-CartesianCoordinate Line::getLocation(double r, bool param)
+CartesianCoordinate Line::getLocation(double r, bool param) const
 {
 	double t;
 	if(param) t = r;
-	else t = r / vector.getMag();
-	return CartesianCoordinate(begin + vector * t);
+	else t = r / norm(vector);
+	return CartesianCoordinate(begin.toVec3() + vector * t);
 }
 
-Vector& Line::getVector()
+const Vec3d& Line::getVector() const
 {
 	return vector;
 }
 
-double Line::length()
+double Line::length() const
 {
-	return vector.getMag();
+	return norm(vector);
 }
 
-Orientation& Line::getOrient()
+Orientation Line::getOrient() const
 {
-	return vector.getOrient();
+	return Vector(vector).getOrient();
 }
 
 void Line::setBegin(const CartesianCoordinate& bp)
 {
 	begin = bp;
-	vector = Vector(begin, end);
+	vector = end.toVec3() - begin.toVec3();
 }
 
 void Line::setEnd(const CartesianCoordinate& ep)
 {
 	end = ep;
-	vector = Vector(begin, end);
+	vector = end.toVec3() - begin.toVec3();
 }
 
 const Line& Line::operator+() const
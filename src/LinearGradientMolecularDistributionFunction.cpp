@@ -0,0 +1,21 @@
+#include <LinearGradientMolecularDistributionFunction.hpp>
+
+namespace motility
+{
+
+LinearGradientMolecularDistributionFunction::LinearGradientMolecularDistributionFunction(double v, double o, double g)
+{
+	value = v;
+	origin = o;
+	gradient = g;
+}
+
+LinearGradientMolecularDistributionFunction::~LinearGradientMolecularDistributionFunction() {}
+
+double LinearGradientMolecularDistributionFunction::operator()(const CartesianCoordinate& loc) const
+{
+	double dens = value * (1 + gradient * (loc.x - origin));
+	return (dens > 0 ? dens : 0);
+}
+
+}
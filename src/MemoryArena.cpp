@@ -0,0 +1,44 @@
+#include <MemoryArena.hpp>
+
+namespace simulation
+{
+
+MemoryArena::MemoryArena() {}
+
+MemoryArena::~MemoryArena() {}
+
+MemoryArena::Resources::Resources() : scratch_arena(scratch_buffer, sizeof(scratch_buffer), std::pmr::new_delete_resource()) {}
+
+MemoryArena::Resources::~Resources()
+{
+	// Restore the default memory resource before the pool goes away.
+	if(std::pmr::get_default_resource() == &model_pool) std::pmr::set_default_resource(std::pmr::new_delete_resource());
+}
+
+std::pmr::memory_resource* MemoryArena::Resources::model()
+{
+	return &model_pool;
+}
+
+std::pmr::memory_resource* MemoryArena::Resources::scratch()
+{
+	return &scratch_arena;
+}
+
+void MemoryArena::Resources::install()
+{
+	std::pmr::set_default_resource(&model_pool);
+}
+
+void MemoryArena::Resources::releaseScratch()
+{
+	scratch_arena.release();
+}
+
+MemoryArena::Resources& MemoryArena::instance()
+{
+	static MemoryArena ma;
+	return ma.resources;
+}
+
+}
@@ -3,11 +3,22 @@
 namespace motility
 {
 
-MolecularDistribution::MolecularDistribution(const SpatialBoundary& bound)
+MolecularDistribution::MolecularDistribution(const SpatialBoundary& bound, Kind k)
 {
 	boundary = bound;
+	kind = k;
 }
 
 MolecularDistribution::~MolecularDistribution() {}
 
+MolecularDistribution::Kind MolecularDistribution::getKind() const
+{
+	return kind;
+}
+
+void MolecularDistribution::getDensities(const CartesianCoordinate* locs, size_t n, double* dens)
+{
+	for(size_t i = 0; i < n; ++i) dens[i] = getDensity(locs[i]);
+}
+
 }
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <cstdlib>
 #include <unistd.h>
 #include <MotileCell.hpp>
@@ -9,59 +11,131 @@
 #include <ParameterTable.hpp>
 #include <ReactionTypeTable.hpp>
 #include <FilamentReaction.hpp>
+#include <NetworkReaction.hpp>
 #include <algorithms.hpp>
+#include <MemoryArena.hpp>
+#include <FlatSet.hpp>
+#include <sampleDensity.hpp>
+#include <mathKernels.hpp>
 
 namespace motility
 {
 
-MotileCell::MotileCell(double max_duration, size_t max_step, double record_time_interval, size_t record_step_interval, UniformMolecularDistribution* ecsd_ptr, const std::string dir, const std::string geom_filename, const std::string geom_filename_ext) : simulation::DiscreteEventSimulator(max_duration, max_step, record_time_interval, record_step_interval)
+MotileCell::MotileCell(double max_duration, size_t max_step, double record_time_interval, size_t record_step_interval, MolecularDistribution* ecsd_ptr, const std::string dir, const std::string geom_filename, const std::string geom_filename_ext) : simulation::DiscreteEventSimulator(max_duration, max_step, record_time_interval, record_step_interval)
 {
 	ecs_dist = ecsd_ptr;
 	data_dir = dir;
 	cell_geom_filename = geom_filename;
 	cell_geom_filename_ext = geom_filename_ext;
 	ParameterTable::Table& param_table = ParameterTable::instance();
-	double x_min = strtod(param_table[std::string("x_min")]);
-	double x_max = strtod(param_table[std::string("x_max")]);
-	double y_min = strtod(param_table[std::string("y_min")]);
-	double y_max = strtod(param_table[std::string("y_max")]);
-	double z_min = strtod(param_table[std::string("z_min")]);
-	double z_max = strtod(param_table[std::string("z_max")]);
+	double x_min = strtod(ParameterTable::lookup("x_min"));
+	double x_max = strtod(ParameterTable::lookup("x_max"));
+	double y_min = strtod(ParameterTable::lookup("y_min"));
+	double y_max = strtod(ParameterTable::lookup("y_max"));
+	double z_min = strtod(ParameterTable::lookup("z_min"));
+	double z_max = strtod(ParameterTable::lookup("z_max"));
 	SpatialBoundary intracellular_molecule_boundary(x_min, x_max, y_min, y_max, z_min, z_max);
 	actin_dist = 0;
-	double actin_conc = strtod(param_table[std::string("actin_conc")]);
+	double actin_conc = strtod(ParameterTable::lookup("actin_conc"));
 	actin_dist = new UniformMolecularDistribution(intracellular_molecule_boundary, actin_conc);
 	arp23_dist = 0;
-	double arp23_conc = strtod(param_table[std::string("arp23_conc")]);
+	double arp23_conc = strtod(ParameterTable::lookup("arp23_conc"));
 	arp23_dist = new UniformMolecularDistribution(intracellular_molecule_boundary, arp23_conc);
 	cap_dist = 0;
-	double cap_conc = strtod(param_table[std::string("cap_conc")]);
+	double cap_conc = strtod(ParameterTable::lookup("cap_conc"));
 	cap_dist = new UniformMolecularDistribution(intracellular_molecule_boundary, cap_conc);
 	adf_dist = 0;
-	double adf_conc = strtod(param_table[std::string("adf_conc")]);
+	double adf_conc = strtod(ParameterTable::lookup("adf_conc"));
 	adf_dist = new UniformMolecularDistribution(intracellular_molecule_boundary, adf_conc);
+	hydrolysis_rate_const = (ReactionTypeTable::lookup("F_ATP <--> F_ADPi")).forward_const;
+	release_rate_const = (ReactionTypeTable::lookup("F_ADPi <--> F_ADP + Pi")).forward_const;
+	cytosol_field = 0;
+	last_field_time = 0;
+	field_update_interval = 0;
+	if(strtob(ParameterTable::lookup("reaction_diffusion")))
+	{
+		field_update_interval = strtod(ParameterTable::lookup("diffusion_update_interval"));
+		double diffusion_grid_spacing = strtod(ParameterTable::lookup("diffusion_grid_spacing"));
+		double diffusion_coef_cytosol = strtod(ParameterTable::lookup("diffusion_coef_cytosol"));
+		double initial_concs[ReactionDiffusionField::SPECIES_NUM];
+		initial_concs[ReactionDiffusionField::ACTIN] = actin_conc;
+		initial_concs[ReactionDiffusionField::ARP23] = arp23_conc;
+		initial_concs[ReactionDiffusionField::CAP] = cap_conc;
+		cytosol_field = new ReactionDiffusionField(intracellular_molecule_boundary, diffusion_grid_spacing, diffusion_coef_cytosol, initial_concs);
+	}
+	network = 0;
+	network_adf = network_adp_adf = network_adp = network_arp23 = network_wasp = ReactionNetwork::species_null;
+	network_stamp = 0;
+	for(size_t s = 0; s < ReactionDiffusionField::SPECIES_NUM; ++s) network_species[s] = ReactionNetwork::species_null;
+	last_network_time = 0;
+	network_update_interval = 0;
+	if(strtob(ParameterTable::lookup("reaction_network")))
+	{
+		network_update_interval = strtod(ParameterTable::lookup("network_update_interval"));
+		std::vector<std::string> compartments;
+		compartments.push_back("cytosol");
+		compartments.push_back("membrane");
+		network = new ReactionNetwork(compartments, strtod(ParameterTable::lookup("network_volume")));
+		// G-actin, Arp23 and ADF start at their uniform concentrations,
+		// and any other species S at the parameter 'S_conc' if given.
+		for(size_t i = 0; i < network->getSpeciesNumber(); ++i)
+		{
+			const std::string& name = network->getSpeciesName(i);
+			double conc = 0;
+			if(name == "G_ATP") conc = actin_conc;
+			else if(name == "Arp23") conc = arp23_conc;
+			else if(name == "ADF") conc = adf_conc;
+			else
+			{
+				ParameterTable::Table::const_iterator param_ptr = param_table.find(name + "_conc");
+				if(param_ptr != param_table.end()) conc = strtod(param_ptr->second);
+			}
+			network->setConcentration(i, conc);
+		}
+		// Filaments grow from ATP-actin and branch from the activated
+		// Arp23 complex, while CP stays outside the network.
+		network_species[ReactionDiffusionField::ACTIN] = network->getSpeciesIndex("G_ATP");
+		network_species[ReactionDiffusionField::ARP23] = network->getSpeciesIndex("Arp23-WASP*-G_ATP");
+		network_adf = network->getSpeciesIndex("ADF");
+		network_adp_adf = network->getSpeciesIndex("G_ADP-ADF");
+		network_adp = network->getSpeciesIndex("G_ADP");
+		network_arp23 = network->getSpeciesIndex("Arp23");
+		network_wasp = network->getSpeciesIndex("WASP");
+	}
 	cell_statistics_calculator = 0;
+	// The geometry is recorded either in OFF-format files or in a single
+	// binary trajectory file.
+	trajectory_writer = 0;
+	std::string trajectory_format = ParameterTable::lookup("trajectory_format");
+	if(trajectory_format == "binary")
+	{
+		trajectory_writer = new TrajectoryWriter(data_dir + cell_geom_filename + ".trj");
+		if(!trajectory_writer->isOpen()) handleErrorEvent("failed to write to " + trajectory_writer->getName());
+	}
+	else if(!trajectory_format.empty() && trajectory_format != "off") handleErrorEvent("unknown trajectory format " + trajectory_format);
 }
 
 MotileCell::~MotileCell() throw()
 {
 	if(cell_statistics_calculator != 0) delete cell_statistics_calculator;
+	if(trajectory_writer != 0) delete trajectory_writer;
 	if(actin_dist != 0) delete actin_dist;
 	if(arp23_dist != 0) delete arp23_dist;
 	if(cap_dist != 0) delete cap_dist;
 	if(adf_dist != 0) delete adf_dist;
+	if(cytosol_field != 0) delete cytosol_field;
+	if(network != 0) delete network;
 }
 
 FilamentBranch MotileCell::makeNewFilament(double rou, double theta, double phi)
 {
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double actin_diameter = strtod(param_table[std::string("actin_diameter")]);
-	double arp23_diameter = strtod(param_table[std::string("arp23_diameter")]);
+	double actin_diameter = strtod(ParameterTable::lookup("actin_diameter"));
+	double arp23_diameter = strtod(ParameterTable::lookup("arp23_diameter"));
 	Orientation orient(theta, phi);
 	SphericalCoordinate local_position(rou, theta, phi);
-	double init_cell_center_x = strtod(param_table[std::string("init_cell_center_x")]);
-	double init_cell_center_y = strtod(param_table[std::string("init_cell_center_y")]);
-	double init_cell_center_z = strtod(param_table[std::string("init_cell_center_z")]);
+	double init_cell_center_x = strtod(ParameterTable::lookup("init_cell_center_x"));
+	double init_cell_center_y = strtod(ParameterTable::lookup("init_cell_center_y"));
+	double init_cell_center_z = strtod(ParameterTable::lookup("init_cell_center_z"));
 	CartesianCoordinate init_cell_center(init_cell_center_x, init_cell_center_y, init_cell_center_z);
 	CartesianCoordinate actual_position = local_position.toCartesianCoordinate() + init_cell_center;
 	ARP23 arp23(0, arp23_diameter, actual_position);
@@ -72,10 +146,9 @@ FilamentBranch MotileCell::makeNewFilament(double rou, double theta, double phi)
 
 void MotileCell::initializeFilamentNetwork()
 {
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double init_cell_diameter = strtod(param_table[std::string("init_cell_diameter")]);
-	size_t n_init_cell_mesh_horizontal = strtoul(param_table[std::string("n_init_cell_mesh_horizontal")]);
-	size_t n_init_cell_mesh_vertical = strtoul(param_table[std::string("n_init_cell_mesh_vertical")]);
+	double init_cell_diameter = strtod(ParameterTable::lookup("init_cell_diameter"));
+	size_t n_init_cell_mesh_horizontal = strtoul(ParameterTable::lookup("n_init_cell_mesh_horizontal"));
+	size_t n_init_cell_mesh_vertical = strtoul(ParameterTable::lookup("n_init_cell_mesh_vertical"));
 	double delta_theta = 2 * M_PI / n_init_cell_mesh_horizontal;
 	double delta_phi = M_PI / n_init_cell_mesh_vertical;
 	// Vary the value of theta and phi by delta_theta and delta_phi
@@ -83,16 +156,28 @@ void MotileCell::initializeFilamentNetwork()
 	BranchTreeHandle new_tree_handle;
 	FilamentBranchHandle new_branch_handle;
 	double theta = 0, phi = 0;
+	// The vertices are indexed in the order of creation: the vertex
+	// at the top of sphere, the vertices at each circle layer and the
+	// vertex at the bottom of sphere. The facets are then listed by the
+	// indices of their vertices and added into cell surface at one time.
+	const size_t nh = n_init_cell_mesh_horizontal;
+	std::vector<VertexHandle> vertex_table;
+	std::vector<size_t> facet_table;
+	vertex_table.reserve(nh * (n_init_cell_mesh_vertical - 1) + 2);
+	facet_table.reserve(6 * nh * (n_init_cell_mesh_vertical - 1));
 	// The double loops are constructed to create all vertices needed
-	// for the initial spherical geometry of fibroblast cell and then
-	// connect the vertices into triangular facets.
+	// for the initial spherical geometry of fibroblast cell and list
+	// the triangular facets connecting them.
 	for(size_t layer_vertical = 0; layer_vertical <= n_init_cell_mesh_vertical; ++layer_vertical)
 	{
 		phi = delta_phi * layer_vertical;
-		if(layer_vertical == 0)
+		size_t layer_horizontal_num = nh;
+		// The vertex at the top or bottom of sphere is a single vertex.
+		if(layer_vertical == 0 || layer_vertical == n_init_cell_mesh_vertical) layer_horizontal_num = 1;
+		for(size_t layer_horizontal = 0; layer_horizontal < layer_horizontal_num; ++layer_horizontal)
 		{
-			// The vertex at the top of sphere
-			filament_network.push_back(BranchTree(makeNewFilament(init_cell_diameter/2, theta, phi)));
+			if(layer_horizontal_num > 1) theta = delta_theta * layer_horizontal;
+			filament_network.emplace_back(makeNewFilament(init_cell_diameter/2, theta, phi));
 			// a new BranchTree is created.
 			new_tree_handle = --(filament_network.end());
 			new_branch_handle = new_tree_handle->getLastBranchHandle();
@@ -109,131 +194,90 @@ void MotileCell::initializeFilamentNetwork()
 			// the vertex. This operation is carried out by the member
 			// function 'addVertex' of Membrane when this vertex is created
 			// and added to cell surface.
-			membrane_surface.addVertex(Vertex(new_branch_handle));
-		}
-		else if(layer_vertical == n_init_cell_mesh_vertical)
-		{
-			// The vertex at the bottom of sphere
-			filament_network.push_back(BranchTree(makeNewFilament(init_cell_diameter/2, theta, phi)));
-			new_tree_handle = --(filament_network.end());
-			new_branch_handle = new_tree_handle->getLastBranchHandle();
-			// Set the associated tree of the new filament branch.
-			new_branch_handle->setTreeHandle(new_tree_handle);
-			// Bi-directionally link the newly created filament and vertex.
-			membrane_surface.addVertex(Vertex(new_branch_handle));
-			// Now add corresponding triangular facets into cell surface
-			VertexHandle vh1, vh2, vh3;
-			vh2 = membrane_surface.getLastVertexHandle();
-			for(size_t layer_horizontal = n_init_cell_mesh_horizontal; layer_horizontal > 0; --layer_horizontal)
+			vertex_table.push_back(membrane_surface.addVertex(Vertex(new_branch_handle)));
+			// Now list corresponding triangular facets.
+			size_t c = vertex_table.size() - 1;
+			if(layer_vertical == 0) {}
+			else if(layer_vertical == n_init_cell_mesh_vertical)
 			{
-				vh1 = vh2;
-				advance(vh1, -ultol(layer_horizontal));
-				vh3 = vh1;
-				if(layer_horizontal == 1) advance(vh3, 1 - ultol(n_init_cell_mesh_horizontal));
-				else advance(vh3, 1);
-				membrane_surface.addFacet(vh1, vh2, vh3);
+				// The vertex at the bottom of sphere
+				for(size_t lh = nh; lh > 0; --lh)
+				{
+					size_t facet[3] = {c - lh, c, (lh > 1 ? c - lh + 1 : c - lh + 1 - nh)};
+					facet_table.insert(facet_table.end(), facet, facet + 3);
+				}
 			}
-		}
-		else
-		{
-			// The vertices at in the middle of sphere
-			for(size_t layer_horizontal = 0; layer_horizontal < n_init_cell_mesh_horizontal; ++layer_horizontal)
+			else if(layer_vertical == 1)
 			{
-				theta = delta_theta * layer_horizontal;
-				filament_network.push_back(BranchTree(makeNewFilament(init_cell_diameter/2, theta, phi)));
-				new_tree_handle = --(filament_network.end());
-				new_branch_handle = new_tree_handle->getLastBranchHandle();
-				// Set the associated tree of the new filament branch.
-				new_branch_handle->setTreeHandle(new_tree_handle);
-				// Bi-directionally link the newly created filament and vertex.
-				membrane_surface.addVertex(Vertex(new_branch_handle));
-				// Now add corresponding triangular facets into cell surface
-				VertexHandle vh1, vh2, vh3;
-				if(layer_vertical == 1)
+				// The vertex at the first circle layer of sphere
+				if(layer_horizontal > 0)
 				{
-					// The vertex at the first circle layer of sphere
-					vh2 = membrane_surface.getLastVertexHandle();
-					vh3 = membrane_surface.getFirstVertexHandle();
-					if(layer_horizontal > 0)
-					{
-						vh1 = vh2;
-						advance(vh1, -1);
-						membrane_surface.addFacet(vh1, vh2, vh3);
-					}
-					if(layer_horizontal == n_init_cell_mesh_horizontal - 1)
-					{
-						vh1 = vh2;
-						advance(vh2, 1 - ultol(n_init_cell_mesh_horizontal));
-						membrane_surface.addFacet(vh1, vh2, vh3);
-					}
+					size_t facet[3] = {c - 1, c, 0};
+					facet_table.insert(facet_table.end(), facet, facet + 3);
+				}
+				if(layer_horizontal == nh - 1)
+				{
+					size_t facet[3] = {c, c + 1 - nh, 0};
+					facet_table.insert(facet_table.end(), facet, facet + 3);
+				}
+			}
+			else
+			{
+				// The vertex at all other vertical layers of sphere,
+				// except for those at the top layer, the first layer
+				// and the bottom layer.
+				if(layer_horizontal == 0)
+				{
+					// The vertex at the first horizontal layer
+					//
+					// Type I triangular facet
+					size_t facet[3] = {c, c + 1 - nh, c - nh};
+					facet_table.insert(facet_table.end(), facet, facet + 3);
 				}
 				else
 				{
-					// The vertex at all other vertical layers of sphere,
-					// except for those at the top layer, the first layer
-					// and the bottom layer.
-					if(layer_horizontal == 0)
+					// The vertex at the middle horizontal layers
+					//
+					// Type II triangular facet
+					size_t facet_ii[3] = {c - 1, c, c - nh};
+					facet_table.insert(facet_table.end(), facet_ii, facet_ii + 3);
+					//
+					// Type I triangular facet
+					if(layer_horizontal < nh - 1)
 					{
-						// The vertex at the first horizontal layer
-						//
-						// Type I triangular facet
-						vh1 = membrane_surface.getLastVertexHandle();
-						vh2 = vh1;
-						advance(vh2, 1 - ultol(n_init_cell_mesh_horizontal));
-						vh3 = vh1;
-						advance(vh3, -ultol(n_init_cell_mesh_horizontal));
-						membrane_surface.addFacet(vh1, vh2, vh3);
+						size_t facet_i[3] = {c, c + 1 - nh, c - nh};
+						facet_table.insert(facet_table.end(), facet_i, facet_i + 3);
 					}
 					else
 					{
-						// The vertex at the middle horizontal layers
-						//
-						// Type II triangular facet
-						vh2 = membrane_surface.getLastVertexHandle();
-						vh1 = vh2;
-						advance(vh1, -1);
-						vh3 = vh2;
-						advance(vh3, -ultol(n_init_cell_mesh_horizontal));
-						membrane_surface.addFacet(vh1, vh2, vh3);
-						//
-						// Type I triangular facet
-						if(layer_horizontal < n_init_cell_mesh_horizontal - 1)
-						{
-							vh1 = vh2;
-							advance(vh2, 1 - ultol(n_init_cell_mesh_horizontal));
-							vh3 = vh2;
-							advance(vh3, -1);
-							membrane_surface.addFacet(vh1, vh2, vh3);
-						}
-						else
-						{
-							vh1 = membrane_surface.getLastVertexHandle();
-							vh3 = vh1;
-							advance(vh3, -ultol(n_init_cell_mesh_horizontal));
-							vh2 = vh3;
-							advance(vh2, 1 - ultol(n_init_cell_mesh_horizontal));
-							membrane_surface.addFacet(vh1, vh2, vh3);
-						}
-					}
-					if(layer_horizontal == n_init_cell_mesh_horizontal - 1)
-					{
-						// The vertex at the last horizontal layer
-						//
-						// Type II triangular facet
-						vh2 = vh1;
-						advance(vh2, 1 - ultol(n_init_cell_mesh_horizontal));
-						vh3 = vh2;
-						advance(vh3, -ultol(n_init_cell_mesh_horizontal));
-						membrane_surface.addFacet(vh1, vh2, vh3);
+						// The vertex at the last horizontal layer closes
+						// the circle layer by a Type I and a Type II facet.
+						size_t facet_i[3] = {c, c + 1 - 2 * nh, c - nh};
+						facet_table.insert(facet_table.end(), facet_i, facet_i + 3);
+						size_t facet_ii[3] = {c, c + 1 - nh, c + 1 - 2 * nh};
+						facet_table.insert(facet_table.end(), facet_ii, facet_ii + 3);
 					}
 				}
 			}
 		}
 	}
+	membrane_surface.addFacets(vertex_table, facet_table);
 }
 
 void MotileCell::initializeFilamentReaction()
 {
+	///
+	/// The reactions of all uncapped filaments are created first
+	/// without evaluating their rates. Since the rate of a reaction
+	/// only reads the geometry of cell and the state of its own
+	/// filament, the rates of different filaments are evaluated in
+	/// parallel. The periods are then drawn serially in the order
+	/// of creation, so that the sequence of random numbers is the
+	/// same as if each reaction is updated on its creation.
+	///
+	std::vector<FilamentReaction_iterator> reaction_ptrs;
+	bool adf_flag = isAdfPresent();
+	size_t reaction_num = (adf_flag ? 4 : 3);
 	for(BranchTreeHandle tree_handle = filament_network.begin(); tree_handle != filament_network.end(); ++tree_handle)
 	{
 		FilamentBranches& branches = tree_handle->getBranches();
@@ -242,16 +286,42 @@ void MotileCell::initializeFilamentReaction()
 			assert(branch_handle->isAttachedToMembrane());
 			if(!branch_handle->isCapped())
 			{
-				FilamentReaction_iterator growing_reaction_ptr = add_event(new FilamentReaction("GROWING", branch_handle, this, ecs_dist));
-				FilamentReaction_iterator branching_reaction_ptr = add_event(new FilamentReaction("BRANCHING", branch_handle, this, ecs_dist));
-				FilamentReaction_iterator capping_reaction_ptr = add_event(new FilamentReaction("CAPPING", branch_handle, this, ecs_dist));
+				FilamentReaction_iterator growing_reaction_ptr = add_event(new FilamentReaction("GROWING", branch_handle, this, false));
+				FilamentReaction_iterator branching_reaction_ptr = add_event(new FilamentReaction("BRANCHING", branch_handle, this, false));
+				FilamentReaction_iterator capping_reaction_ptr = add_event(new FilamentReaction("CAPPING", branch_handle, this, false));
 				branch_handle->addReaction(growing_reaction_ptr);
 				branch_handle->addReaction(branching_reaction_ptr);
 				branch_handle->addReaction(capping_reaction_ptr);
 				associateNewFilamentReaction(growing_reaction_ptr, branching_reaction_ptr, capping_reaction_ptr);
+				reaction_ptrs.push_back(growing_reaction_ptr);
+				reaction_ptrs.push_back(branching_reaction_ptr);
+				reaction_ptrs.push_back(capping_reaction_ptr);
+				if(adf_flag)
+				{
+					FilamentReaction_iterator severing_reaction_ptr = add_event(new FilamentReaction("SEVERING", branch_handle, this, false));
+					branch_handle->addReaction(severing_reaction_ptr);
+					associateSeveringReaction(severing_reaction_ptr, growing_reaction_ptr, branching_reaction_ptr, capping_reaction_ptr);
+					reaction_ptrs.push_back(severing_reaction_ptr);
+				}
 			}
 		}
 	}
+	// The reactions of a filament are evaluated by the same thread
+	// because the branching reaction caches the orientation of child
+	// filament in its filament.
+	long filament_num = static_cast<long>(reaction_ptrs.size() / reaction_num);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	for(long i = 0; i < filament_num; ++i)
+	{
+		for(size_t j = 0; j < reaction_num; ++j) (*reaction_ptrs[reaction_num * i + j])->update_rate();
+	}
+	for(size_t i = 0; i < reaction_ptrs.size(); ++i)
+	{
+		(*reaction_ptrs[i])->update_period();
+		(*reaction_ptrs[i])->set_state(true);
+	}
 }
 
 void MotileCell::associateNewFilamentReaction(FilamentReaction_iterator growing_reaction_ptr, FilamentReaction_iterator branching_reaction_ptr, FilamentReaction_iterator capping_reaction_ptr)
@@ -268,15 +338,124 @@ void MotileCell::associateNewFilamentReaction(FilamentReaction_iterator growing_
 	add_destruction(capping_reaction_ptr, capping_reaction_ptr);
 }
 
+void MotileCell::associateSeveringReaction(FilamentReaction_iterator severing_reaction_ptr, FilamentReaction_iterator growing_reaction_ptr, FilamentReaction_iterator branching_reaction_ptr, FilamentReaction_iterator capping_reaction_ptr)
+{
+	// The severing reaction depends on the length of its filament, and
+	// is destroyed together with other reactions when it is capped.
+	add_modification(growing_reaction_ptr, severing_reaction_ptr);
+	add_modification(branching_reaction_ptr, severing_reaction_ptr);
+	add_destruction(capping_reaction_ptr, severing_reaction_ptr);
+}
+
+void MotileCell::initializeNetworkReaction()
+{
+	if(network == 0) return;
+	if(ParameterTable::lookup("network_method") == "tau_leap")
+	{
+		double network_leap_period = strtod(ParameterTable::lookup("network_leap_period"));
+		FilamentReaction_iterator leaping_reaction_ptr = add_event(new NetworkReaction(network, network_leap_period, &network_engine));
+		add_modification(leaping_reaction_ptr, leaping_reaction_ptr);
+		network_reaction_ptrs.push_back(leaping_reaction_ptr);
+		return;
+	}
+	for(size_t c = 0; c < network->getChannelNumber(); ++c) network_reaction_ptrs.push_back(add_event(new NetworkReaction(network, c)));
+	network_channel_stamps.assign(network->getChannelNumber(), 0);
+	// The connections of the exact reactions never change. Every
+	// reaction modifies itself so that its period is redrawn after it
+	// occurs, even if it does not consume its own reactants.
+	std::vector<size_t> affected_channels;
+	for(size_t c = 0; c < network->getChannelNumber(); ++c)
+	{
+		add_modification(network_reaction_ptrs[c], network_reaction_ptrs[c]);
+		network->getAffectedChannels(c, affected_channels);
+		for(size_t i = 0; i < affected_channels.size(); ++i)
+		{
+			if(affected_channels[i] != c) add_modification(network_reaction_ptrs[c], network_reaction_ptrs[affected_channels[i]]);
+		}
+	}
+}
+
+void MotileCell::exchangeNetworkMolecules(size_t species, long n)
+{
+	if(network != 0 && species != ReactionNetwork::species_null) network->addMolecules(species, n);
+}
+
+void MotileCell::modifyNetworkReactions(FilamentReaction_iterator reaction_ptr, size_t species)
+{
+	// Only the exact reactions have rates depending on the species. A
+	// channel depending on several species is added once, as marked by
+	// the stamp of the current connection.
+	if(network == 0 || species == ReactionNetwork::species_null || network_reaction_ptrs.size() != network->getChannelNumber()) return;
+	for(const size_t* c = network->beginDependents(species); c != network->endDependents(species); ++c)
+	{
+		if(network_channel_stamps[*c] == network_stamp) continue;
+		network_channel_stamps[*c] = network_stamp;
+		add_modification(reaction_ptr, network_reaction_ptrs[*c]);
+	}
+}
+
+bool MotileCell::isNetworkAdfAvailable() const
+{
+	return (cytosol_field != 0 || network == 0 || network_adf == ReactionNetwork::species_null || network->getCount(network_adf) > 0);
+}
+
+void MotileCell::releaseFilamentMolecules(FilamentBranchHandle branch_handle)
+{
+	/// The monomers of a removed filament are released at its middle
+	/// together with its cap and ARP23 into the reaction-diffusion
+	/// field, or as ADP-actin and free Arp23 into the reaction network
+	/// which leaves out CP.
+	FilamentBranch& branch = *branch_handle;
+	if(cytosol_field != 0)
+	{
+		CartesianCoordinate middle = (branch.getHeadEndLocation() + branch.getTailEndLocation()) / 2;
+		cytosol_field->addMolecules(ReactionDiffusionField::ACTIN, middle, static_cast<double>(branch.length()));
+		if(branch.isCapped()) cytosol_field->addMolecules(ReactionDiffusionField::CAP, middle, 1);
+		if(branch.isArp23ed()) cytosol_field->addMolecules(ReactionDiffusionField::ARP23, middle, 1);
+	}
+	else
+	{
+		exchangeNetworkMolecules(network_adp, static_cast<long>(branch.length()));
+		if(branch.isArp23ed()) exchangeNetworkMolecules(network_arp23, 1);
+	}
+}
+
+bool MotileCell::isAdfPresent() const
+{
+	return (strtod(ParameterTable::lookup("adf_conc")) > 0);
+}
+
+void MotileCell::discardFilamentReactions(FilamentBranchHandle branch_handle)
+{
+	FilamentReaction_iterators& reaction_ptrs = branch_handle->getReactions();
+	removed_reactions.insert(removed_reactions.end(), reaction_ptrs.begin(), reaction_ptrs.end());
+}
+
+void MotileCell::removeFilament(FilamentBranchHandle branch_handle)
+{
+	BranchTreeHandle tree_handle = branch_handle->getTreeHandle();
+	FilamentBranchHandles& children = branch_handle->getChildHandles();
+	while(!children.empty())
+	{
+		filament_network.emplace_back();
+		tree_handle->moveFilamentSubtree(children.front(), --(filament_network.end()));
+	}
+	releaseFilamentMolecules(branch_handle);
+	tree_handle->removeFilamentBranch(branch_handle);
+	if(tree_handle->isEmpty()) filament_network.erase(tree_handle);
+}
+
 void MotileCell::connect(FilamentReaction_iterator reaction_ptr)
 {
+	// The connections of the network reactions are set up once.
+	FilamentReaction* reaction = dynamic_cast<FilamentReaction*>(*reaction_ptr);
+	if(reaction == 0) return;
 	// Remove all existing modification and destruction connections
 	// of a reaction.
 	empty_modified_events(reaction_ptr);
 	empty_destroyed_events(reaction_ptr);
 	// Add the reactions associated with all affected filaments to
 	// the modified and/or the destroyed reactions of this reaction.
-	FilamentReaction* reaction = dynamic_cast<FilamentReaction*>(*reaction_ptr);
 	FilamentBranchHandle filament_ptr = reaction->getFilament();
 	const std::string& reaction_type = reaction->getType();
 	FilamentBranchHandles& affected_filament_ptrs = reaction->getAffectedFilaments();
@@ -287,18 +466,45 @@ void MotileCell::connect(FilamentReaction_iterator reaction_ptr)
 		{
 			if(*affected_filament_ptr_ptr == filament_ptr)
 			{
-				if(reaction_type == "GROWING" || reaction_type == "BRANCHING") add_modification(reaction_ptr, *affected_filament_reaction_ptr_ptr);
+				if(reaction_type == "GROWING" || reaction_type == "BRANCHING" || reaction_type == "SHRINKING") add_modification(reaction_ptr, *affected_filament_reaction_ptr_ptr);
 				else if(reaction_type == "CAPPING") add_destruction(reaction_ptr, *affected_filament_reaction_ptr_ptr);
+				// A severing reaction rejected at an ATP or ADP-Pi site
+				// leaves its filament intact and only redraws itself.
+				else if(reaction_type == "SEVERING" && *affected_filament_reaction_ptr_ptr == reaction_ptr) add_modification(reaction_ptr, reaction_ptr);
 				else {}
 			}
 			else add_modification(reaction_ptr, *affected_filament_reaction_ptr_ptr);
 		}
 	}
+	// The exact network reactions depending on the molecules taken or
+	// released by this reaction are modified.
+	if(network != 0)
+	{
+		++network_stamp;
+		if(reaction_type == "GROWING") modifyNetworkReactions(reaction_ptr, network_species[ReactionDiffusionField::ACTIN]);
+		else if(reaction_type == "BRANCHING")
+		{
+			modifyNetworkReactions(reaction_ptr, network_species[ReactionDiffusionField::ACTIN]);
+			modifyNetworkReactions(reaction_ptr, network_species[ReactionDiffusionField::ARP23]);
+			modifyNetworkReactions(reaction_ptr, network_wasp);
+		}
+		else if(reaction_type == "SHRINKING")
+		{
+			modifyNetworkReactions(reaction_ptr, network_adf);
+			modifyNetworkReactions(reaction_ptr, network_adp_adf);
+		}
+		else {}
+	}
+	// The reactions of the filaments removed by this reaction, possibly
+	// including this reaction itself, are destroyed.
+	for(FilamentReaction_iterator_iterator removed_reaction_ptr_ptr = removed_reactions.begin(); removed_reaction_ptr_ptr != removed_reactions.end(); ++removed_reaction_ptr_ptr) add_destruction(reaction_ptr, *removed_reaction_ptr_ptr);
+	removed_reactions.clear();
 }
 
 void MotileCell::create(FilamentReaction_iterator reaction_ptr)
 {
 	FilamentReaction* reaction = dynamic_cast<FilamentReaction*>(*reaction_ptr);
+	if(reaction == 0) return;
 	if(reaction->getType() == "BRANCHING")
 	{
 		FilamentBranchHandle filament_ptr = reaction->getFilament();
@@ -308,29 +514,47 @@ void MotileCell::create(FilamentReaction_iterator reaction_ptr)
 		// newly created filament. Also remember to associate these new
 		// filament reactions with the reactions on the mother filament.
 		FilamentBranchHandle new_branch_ptr = tree_ptr->getLastBranchHandle();
-		FilamentReaction_iterator growing_reaction_ptr = add_event(new FilamentReaction("GROWING", new_branch_ptr, this, ecs_dist));
-		FilamentReaction_iterator branching_reaction_ptr = add_event(new FilamentReaction("BRANCHING", new_branch_ptr, this, ecs_dist));
-		FilamentReaction_iterator capping_reaction_ptr = add_event(new FilamentReaction("CAPPING", new_branch_ptr, this, ecs_dist));
+		FilamentReaction_iterator growing_reaction_ptr = add_event(new FilamentReaction("GROWING", new_branch_ptr, this));
+		FilamentReaction_iterator branching_reaction_ptr = add_event(new FilamentReaction("BRANCHING", new_branch_ptr, this));
+		FilamentReaction_iterator capping_reaction_ptr = add_event(new FilamentReaction("CAPPING", new_branch_ptr, this));
 		new_branch_ptr->addReaction(growing_reaction_ptr);
 		new_branch_ptr->addReaction(branching_reaction_ptr);
 		new_branch_ptr->addReaction(capping_reaction_ptr);
 		associateNewFilamentReaction(growing_reaction_ptr, branching_reaction_ptr, capping_reaction_ptr);
+		if(isAdfPresent())
+		{
+			FilamentReaction_iterator severing_reaction_ptr = add_event(new FilamentReaction("SEVERING", new_branch_ptr, this));
+			new_branch_ptr->addReaction(severing_reaction_ptr);
+			associateSeveringReaction(severing_reaction_ptr, growing_reaction_ptr, branching_reaction_ptr, capping_reaction_ptr);
+		}
+	}
+	else if(reaction->getType() == "CAPPING" && isAdfPresent())
+	{
+		// A capped filament is depolymerized by ADF from its barbed
+		// end. The reactions of its uncapped state have been destroyed
+		// before this function is called.
+		FilamentBranchHandle filament_ptr = reaction->getFilament();
+		FilamentReaction_iterator shrinking_reaction_ptr = add_event(new FilamentReaction("SHRINKING", filament_ptr, this));
+		filament_ptr->addReaction(shrinking_reaction_ptr);
+		add_modification(shrinking_reaction_ptr, shrinking_reaction_ptr);
 	}
 }
 void MotileCell::pre_remove_event(FilamentReaction_iterator reaction_ptr, FilamentReaction_iterator destroyed_reaction_ptr)
 {
 	// Remove the reaction to be destroyed from the reaction list
-	// of the filament to which this reaction belongs.
+	// of the filament to which this reaction belongs, unless the
+	// filament has been removed.
 	FilamentReaction* destroyed_reaction = dynamic_cast<FilamentReaction*>(*destroyed_reaction_ptr);
-	destroyed_reaction->getFilament()->getReactions().remove(destroyed_reaction_ptr);
+	if(destroyed_reaction->isFilamentValid()) destroyed_reaction->getFilament()->getReactions().remove(destroyed_reaction_ptr);
 }
 
 void MotileCell::pre_remove_event(FilamentReaction_iterator reaction_ptr)
 {
 	// Remove the reaction to be destroyed from the reaction list
-	// of the filament to which this reaction belongs.
+	// of the filament to which this reaction belongs, unless the
+	// filament has been removed.
 	FilamentReaction* reaction = dynamic_cast<FilamentReaction*>(*reaction_ptr);
-	reaction->getFilament()->getReactions().remove(reaction_ptr);
+	if(reaction->isFilamentValid()) reaction->getFilament()->getReactions().remove(reaction_ptr);
 }
 
 void MotileCell::step_record()
@@ -341,52 +565,166 @@ void MotileCell::step_record()
 	std::cout << std::endl;
 }
 
+void MotileCell::ageFilamentNetwork()
+{
+	for(BranchTreeHandle tree_handle = filament_network.begin(); tree_handle != filament_network.end(); ++tree_handle)
+	{
+		FilamentBranches& branches = tree_handle->getBranches();
+		for(FilamentBranchHandle branch_handle = branches.begin(); branch_handle != branches.end(); ++branch_handle) branch_handle->ageNucleotides(time_moment, hydrolysis_rate_const, release_rate_const, nucleotide_engine);
+	}
+}
+
+const EnvironmentSample& MotileCell::getEnvironment(FilamentBranchHandle branch_handle)
+{
+	// The environment is sampled once after each move of the tail end,
+	// which only writes the state of this filament. The cytosolic
+	// distributions are final, so their densities are sampled by direct
+	// calls, and the extracellular signal is dispatched on its kind.
+	FilamentState& state = FilamentStateTable::instance()[branch_handle->getId()];
+	EnvironmentSample& environment = state.environment;
+	if(!environment.valid)
+	{
+		const CartesianCoordinate tip = GeometryPrecision::loadCoordinate(state.tail_end_location);
+		environment.in_signal = !isEqual(sampleDensity(*ecs_dist, tip), 0);
+		environment.actin = actin_dist->getDensity(tip);
+		environment.arp23 = arp23_dist->getDensity(tip);
+		environment.cap = cap_dist->getDensity(tip);
+		environment.adf = adf_dist->getDensity(tip);
+		environment.valid = true;
+	}
+	return environment;
+}
+
+bool MotileCell::isTipInSignal(FilamentBranchHandle branch_handle)
+{
+	return getEnvironment(branch_handle).in_signal;
+}
+
+double MotileCell::getAdfConcentration(FilamentBranchHandle branch_handle)
+{
+	if(cytosol_field == 0 && network != 0 && network_adf != ReactionNetwork::species_null) return network->getConcentration(network_adf);
+	return getEnvironment(branch_handle).adf;
+}
+
+double MotileCell::getCytosolicConcentration(ReactionDiffusionField::Species s, FilamentBranchHandle branch_handle)
+{
+	if(cytosol_field != 0) return cytosol_field->getTipConcentration(s, *branch_handle);
+	if(network != 0 && network_species[s] != ReactionNetwork::species_null) return network->getConcentration(network_species[s]);
+	const EnvironmentSample& environment = getEnvironment(branch_handle);
+	double conc;
+	switch(s)
+	{
+		case ReactionDiffusionField::ACTIN: conc = environment.actin; break;
+		case ReactionDiffusionField::ARP23: conc = environment.arp23; break;
+		default: conc = environment.cap; break;
+	}
+	return conc;
+}
+
+void MotileCell::integrate()
+{
+	/// The cytosolic field is advanced by operator splitting. Between
+	/// two updates, the reactions only consume and release molecules
+	/// in the field. Each update diffuses the field over the elapsed
+	/// period and re-evaluates all reactions with the new tip
+	/// concentrations. Likewise, the filament reactions only see the
+	/// concentrations of the reaction network as of their latest
+	/// evaluation, so all reactions are re-evaluated at intervals.
+	bool refresh_flag = false;
+	if(cytosol_field != 0)
+	{
+		if(time_moment - last_field_time >= field_update_interval)
+		{
+			cytosol_field->advance(time_moment - last_field_time);
+			last_field_time = time_moment;
+			refresh_flag = true;
+		}
+	}
+	if(network != 0)
+	{
+		if(time_moment - last_network_time >= network_update_interval)
+		{
+			last_network_time = time_moment;
+			refresh_flag = true;
+		}
+	}
+	if(refresh_flag) refresh_events();
+}
+
 void MotileCell::time_record()
 {
 	simulation::DiscreteEventSimulator::time_record();
+	// The nucleotides are aged lazily, so bring all filaments up to
+	// date before recording.
+	ageFilamentNetwork();
 	std::cout << "At the time " << time_moment << " sec (step #" << loop_step << ") :" << std::endl;
 	// Record a snapshot of cell geometry.
 	std::stringstream strs;
-	strs << data_dir << cell_geom_filename << '-' << time_moment << 's' << '.' << cell_geom_filename_ext;
-	std::string current_geom_filename = strs.str();
-	std::cout << "Writing " << current_geom_filename << std::endl;
-	OutputFile current_geom_file(current_geom_filename);
-	membrane_surface.exportGeometry(current_geom_file.getStream());
+	strs << time_moment << 's';
+	recordCellGeometry(strs.str());
 	(*cell_statistics_calculator)(this, ecs_dist, time_moment, true);
 	std::cout << std::endl;
 }
 
+void MotileCell::recordCellGeometry(const std::string& suffix)
+{
+	trajectory_frame.time = time_moment;
+	membrane_surface.exportGeometry(trajectory_frame);
+	if(trajectory_writer != 0)
+	{
+		std::cout << "Writing frame #" << trajectory_writer->getFrameSize() << " of " << trajectory_writer->getName() << std::endl;
+		trajectory_writer->write(trajectory_frame);
+	}
+	else
+	{
+		std::string cell_geom_filename_full = data_dir + cell_geom_filename + '-' + suffix + '.' + cell_geom_filename_ext;
+		std::cout << "Writing " << cell_geom_filename_full << std::endl;
+		OutputFile cell_geom_file(cell_geom_filename_full);
+		trajectory_frame.exportGeometry(cell_geom_file.getStream());
+	}
+}
+
 void MotileCell::initialize()
 {
 	// Initialize filament network.
 	initializeFilamentNetwork();
+	// Make room for the tip concentrations of the initial filaments
+	// before their rates are evaluated in parallel.
+	if(cytosol_field != 0) cytosol_field->advance(0);
 	// Initialize filament reaction.
 	initializeFilamentReaction();
+	// Initialize the reactions of the reaction network.
+	initializeNetworkReaction();
 	// Sort the initial event pool.
 	simulation::DiscreteEventSimulator::initialize();
 	// Record the initial cell geometry.
-	std::string cell_geom_start_filename = data_dir + cell_geom_filename + "-start" + '.' + cell_geom_filename_ext;
-	std::cout << "Writing " << cell_geom_start_filename << std::endl;
-	OutputFile cell_geom_start_file(cell_geom_start_filename);
-	membrane_surface.exportGeometry(cell_geom_start_file.getStream());
+	recordCellGeometry("start");
 	// Initialize the calculator.
 	cell_statistics_calculator = new CellStatisticsCalculator(this, ecs_dist, time_moment, data_dir);
 	// Determine whether to initialize randome generator randomly.
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	bool random_seed = strtob(param_table[std::string("random_seed")]);
-	if(random_seed) srandom(time(0) * getpid());
-	else srandom(1);
+	bool random_seed = strtob(ParameterTable::lookup("random_seed"));
+	if(random_seed)
+	{
+		srandom(time(0) * getpid());
+		nucleotide_engine.seed(time(0) * getpid());
+		network_engine.seed(time(0) * getpid());
+	}
+	else
+	{
+		srandom(1);
+		nucleotide_engine.seed(1);
+		network_engine.seed(1);
+	}
 	std::cout << "Start simulation..." << std::endl;
 }
 
 void MotileCell::finalize()
 {
 	simulation::DiscreteEventSimulator::finalize();
-	// Record the final cell geometry.
-	std::string cell_geom_end_filename = data_dir + cell_geom_filename + "-end" + '.' + cell_geom_filename_ext;
-	std::cout << "Writing " << cell_geom_end_filename << std::endl;
-	OutputFile cell_geom_end_file(cell_geom_end_filename);
-	membrane_surface.exportGeometry(cell_geom_end_file.getStream());
+	// Record the final cell geometry, after which the index of the
+	// binary trajectory file is written.
+	recordCellGeometry("end");
+	if(trajectory_writer != 0) trajectory_writer->close();
 	// Print some overall simulation information.
 	std::cout << "Simulation is done! " << std::endl;
 	std::cout << "Total simulation time is " << time_moment << " seconds and simulation step is " << loop_step << "." << std::endl;
@@ -425,22 +763,21 @@ SurfaceTopology& MotileCell::getMembraneSurface()
 double MotileCell::computeEnergyChange(FilamentBranchHandle branch_handle, const std::string& type)
 {
 	double energy_change = 0;
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double filament_membrane_resistance_pressure = strtod(param_table[std::string("filament_membrane_resistance_pressure")]);
-	double actin_diameter = strtod(param_table[std::string("actin_diameter")]);
+	double filament_membrane_resistance_pressure = strtod(ParameterTable::lookup("filament_membrane_resistance_pressure"));
+	double actin_diameter = strtod(ParameterTable::lookup("actin_diameter"));
 	if(type == "GROWING" || type == "CAPPING")
 	{
-		Vector filament_vector(1, branch_handle->getOrient());
-		Vector centered_direct_area = membrane_surface.computeCenteredDirectionalAreaOfLocalSurface(branch_handle->getVertex());
-		Vector total_resistance_force = centered_direct_area * filament_membrane_resistance_pressure;
+		Vec3d filament_vector = branch_handle->getDirection().toVec3();
+		Vec3d centered_direct_area = membrane_surface.computeCenteredDirectionalAreaOfLocalSurface(branch_handle->getVertex());
+		Vec3d total_resistance_force = centered_direct_area * filament_membrane_resistance_pressure;
 		energy_change = dotProd(total_resistance_force, -filament_vector) * actin_diameter / 2;
 	}
 	else if(type == "BRANCHING")
 	{
-		Vector filament_vector(branch_handle->getInitialLength(), branch_handle->getChildBranchOrient());
+		Vec3d filament_vector = Vector(branch_handle->getInitialLength(), branch_handle->getChildBranchOrient()).toVec3();
 		Line child_branch_line(branch_handle->getBranchingSiteActinLocation(), filament_vector);
-		Vector centered_direct_area = membrane_surface.computeCenteredDirectionalAreaOfLocalSurface(child_branch_line.getEnd(), branch_handle->getChildBranchFacet());
-		Vector total_resistance_force = centered_direct_area * filament_membrane_resistance_pressure;
+		Vec3d centered_direct_area = membrane_surface.computeCenteredDirectionalAreaOfLocalSurface(child_branch_line.getEnd(), branch_handle->getChildBranchFacet());
+		Vec3d total_resistance_force = centered_direct_area * filament_membrane_resistance_pressure;
 		energy_change = dotProd(total_resistance_force, -filament_vector) * actin_diameter / 2;
 	}
 	else {}
@@ -449,19 +786,17 @@ double MotileCell::computeEnergyChange(FilamentBranchHandle branch_handle, const
 
 double MotileCell::computeFilamentGrowingRate(FilamentBranchHandle branch_handle)
 {
-	ReactionTypeTable::Table& reac_table = ReactionTypeTable::instance();
-	double growing_rate_const = (reac_table[std::string("growing")]).forward_const;
+	double growing_rate_const = (ReactionTypeTable::lookup("growing")).forward_const;
 	double growing_rate;
 	if(growing_rate_const < DBL_EPSILON) growing_rate = 0;
 	else if(growing_rate_const < DBL_INF_POSITIVE)
 	{
 		// Calculate resistance factor.
 		double energy_change = computeEnergyChange(branch_handle, "GROWING");
-		ParameterTable::Table& param_table = ParameterTable::instance();
-		double kT = strtod(param_table[std::string("kT")]);
+		double kT = strtod(ParameterTable::lookup("kT"));
 		double resistance_factor = 1;
-		if(energy_change > DBL_EPSILON) resistance_factor = std::exp(-energy_change / kT);
-		double actin_conc = actin_dist->getDensity(branch_handle->getTailEndLocation());
+		if(energy_change > DBL_EPSILON) resistance_factor = simulation::math::boltzmannFactor(energy_change / kT);
+		double actin_conc = getCytosolicConcentration(ReactionDiffusionField::ACTIN, branch_handle);
 		growing_rate = growing_rate_const * actin_conc * resistance_factor;
 	}
 	else growing_rate = DBL_INF_POSITIVE;
@@ -470,8 +805,7 @@ double MotileCell::computeFilamentGrowingRate(FilamentBranchHandle branch_handle
 
 double MotileCell::computeFilamentBranchingRate(FilamentBranchHandle branch_handle)
 {
-	ReactionTypeTable::Table& reac_table = ReactionTypeTable::instance();
-	double branching_rate_const = (reac_table[std::string("branching")]).forward_const;
+	double branching_rate_const = (ReactionTypeTable::lookup("branching")).forward_const;
 	double branching_rate;
 	if(branching_rate_const < DBL_EPSILON) branching_rate = 0;
 	else if(branching_rate_const < DBL_INF_POSITIVE)
@@ -484,15 +818,14 @@ double MotileCell::computeFilamentBranchingRate(FilamentBranchHandle branch_hand
 		{
 			// Calculate resistance factor.
 			double energy_change = computeEnergyChange(branch_handle, "BRANCHING");
-			ParameterTable::Table& param_table = ParameterTable::instance();
-			double kT = strtod(param_table[std::string("kT")]);
+			double kT = strtod(ParameterTable::lookup("kT"));
 			double resistance_factor = 1;
-			if(energy_change > DBL_EPSILON) resistance_factor = std::exp(-energy_change / kT);
+			if(energy_change > DBL_EPSILON) resistance_factor = simulation::math::boltzmannFactor(energy_change / kT);
 			// Caluclate the rate of filament branching reaction.
-			double arp23_conc = arp23_dist->getDensity(branch_handle->getTailEndLocation());
+			double arp23_conc = getCytosolicConcentration(ReactionDiffusionField::ARP23, branch_handle);
 			branching_rate = branching_rate_const * arp23_conc * resistance_factor;
-			double actin_conc = actin_dist->getDensity(branch_handle->getTailEndLocation());
-			size_t branching_actin_quantity = strtoul(param_table[std::string("branching_actin_quantity")]);
+			double actin_conc = getCytosolicConcentration(ReactionDiffusionField::ACTIN, branch_handle);
+			size_t branching_actin_quantity = strtoul(ParameterTable::lookup("branching_actin_quantity"));
 			for(size_t i = 0; i < branching_actin_quantity; ++i) branching_rate *= actin_conc;
 		}
 		else branching_rate = 0;
@@ -503,8 +836,7 @@ double MotileCell::computeFilamentBranchingRate(FilamentBranchHandle branch_hand
 
 double MotileCell::computeFilamentCappingRate(FilamentBranchHandle branch_handle)
 {
-	ReactionTypeTable::Table& reac_table = ReactionTypeTable::instance();
-	double capping_rate_const = (reac_table[std::string("capping")]).forward_const;
+	double capping_rate_const = (ReactionTypeTable::lookup("capping")).forward_const;
 	double capping_rate;
 	if(capping_rate_const < DBL_EPSILON) capping_rate = 0;
 	else if(capping_rate_const < DBL_INF_POSITIVE)
@@ -519,18 +851,57 @@ double MotileCell::computeFilamentCappingRate(FilamentBranchHandle branch_handle
 		// raise up membrane energy significantly.
 		// Calculate resistance factor.
 		double energy_change = computeEnergyChange(branch_handle, "CAPPING");
-		ParameterTable::Table& param_table = ParameterTable::instance();
-		double kT = strtod(param_table[std::string("kT")]);
+		double kT = strtod(ParameterTable::lookup("kT"));
 		double resistance_factor = 1;
-		if(energy_change > DBL_EPSILON) resistance_factor = std::exp(-energy_change / kT);
+		if(energy_change > DBL_EPSILON) resistance_factor = simulation::math::boltzmannFactor(energy_change / kT);
 		// Caluclate the rate of filament capping reaction.
-		double cap_conc = cap_dist->getDensity(branch_handle->getTailEndLocation());
+		double cap_conc = getCytosolicConcentration(ReactionDiffusionField::CAP, branch_handle);
 		capping_rate = capping_rate_const * cap_conc * resistance_factor;
 	}
 	else capping_rate = DBL_INF_POSITIVE;
 	return capping_rate;
 }
 
+double MotileCell::computeFilamentShrinkingRate(FilamentBranchHandle branch_handle)
+{
+	double shrinking_rate_const = (ReactionTypeTable::lookup("shrinking")).forward_const;
+	size_t branching_actin_quantity = strtoul(ParameterTable::lookup("branching_actin_quantity"));
+	double shrinking_rate;
+	// The nucleus of a filament is never depolymerized.
+	if(shrinking_rate_const < DBL_EPSILON || branch_handle->length() <= branching_actin_quantity) shrinking_rate = 0;
+	else if(shrinking_rate_const < DBL_INF_POSITIVE)
+	{
+		double adf_conc = getAdfConcentration(branch_handle);
+		shrinking_rate = shrinking_rate_const * adf_conc;
+	}
+	else shrinking_rate = DBL_INF_POSITIVE;
+	return shrinking_rate;
+}
+
+double MotileCell::computeFilamentSeveringRate(FilamentBranchHandle branch_handle)
+{
+	/// ADF binds to the ADP-actin monomers of a filament and severs
+	/// the filament at the bound monomer much faster than it binds,
+	/// so the binding is the rate-limiting step. The nucleotides are
+	/// aged lazily, so the number of ADP-actin monomers is not known
+	/// between two events of the filament. The rate is therefore
+	/// bounded by taking every monomer but the first one as a site,
+	/// and the sites holding ATP or ADP-Pi are rejected when the
+	/// reaction occurs.
+	double binding_rate_const = (ReactionTypeTable::lookup("F_ADP + ADF <--> F_ADP-ADF")).forward_const;
+	size_t site_num = 0;
+	if(branch_handle->length() > 1) site_num = branch_handle->length() - 1;
+	double severing_rate;
+	if(binding_rate_const < DBL_EPSILON || site_num == 0) severing_rate = 0;
+	else if(binding_rate_const < DBL_INF_POSITIVE)
+	{
+		double adf_conc = getAdfConcentration(branch_handle);
+		severing_rate = binding_rate_const * adf_conc * site_num;
+	}
+	else severing_rate = DBL_INF_POSITIVE;
+	return severing_rate;
+}
+
 void MotileCell::updateCappedFilamentAttachmentToMembrane(VertexHandles& vertices)
 {
 	/// If the local surface around a capped vertex has a concave shape,
@@ -544,13 +915,16 @@ void MotileCell::updateCappedFilamentAttachmentToMembrane(VertexHandles& vertice
 	/// by capFilament does not include this filament itself. Therefore
 	/// this filament remains valid through subsequent update of reacton
 	/// interactions.
-	VertexHandles affected_vertices;
+	/// The neighboring vertices are collected with duplicates, which
+	/// are removed together with the given vertices at the end.
+	std::pmr::memory_resource* scratch = simulation::MemoryArena::instance().scratch();
+	std::pmr::vector<VertexHandle> affected_vertices(scratch);
 	VertexHandleHandle vhh = vertices.begin();
 	while(vhh != vertices.end())
 	{
 		bool vertex_removed_flag = false;
 		FilamentBranchHandle branch_handle = (*vhh)->getFilament();
-		if(!isEqual(ecs_dist->getDensity(branch_handle->getTailEndLocation()), 0) && branch_handle->isCapped())
+		if(isTipInSignal(branch_handle) && branch_handle->isCapped())
 		{
 			double surface_energy_change = computeEnergyChange(branch_handle, "GROWING");
 			if(surface_energy_change < -DBL_EPSILON)
@@ -565,11 +939,10 @@ void MotileCell::updateCappedFilamentAttachmentToMembrane(VertexHandles& vertice
 				// vertices later.
 				FilamentBranchHandle branch_handle_removed = (*vhh)->getFilament();
 				VertexHandles neighboring_vertices = membrane_surface.removeVertex(*vhh);
-				affected_vertices = merge<VertexHandle>(affected_vertices, neighboring_vertices);
-				affected_vertices.remove(*vhh);
-				BranchTreeHandle tree_handle_removed = branch_handle_removed->getTreeHandle();
-				tree_handle_removed->removeFilamentBranch(branch_handle_removed);
-				if(tree_handle_removed->isEmpty()) filament_network.erase(tree_handle_removed);
+				affected_vertices.insert(affected_vertices.end(), neighboring_vertices.begin(), neighboring_vertices.end());
+				affected_vertices.erase(std::remove(affected_vertices.begin(), affected_vertices.end(), *vhh), affected_vertices.end());
+				discardFilamentReactions(branch_handle_removed);
+				removeFilament(branch_handle_removed);
 				VertexHandleHandle vhh_removed = vhh++;
 				vertices.erase(vhh_removed);
 				vertex_removed_flag = true;
@@ -578,7 +951,9 @@ void MotileCell::updateCappedFilamentAttachmentToMembrane(VertexHandles& vertice
 		if(!vertex_removed_flag) ++vhh;
 	}
 	// Update the list of affected vertices.
-	vertices = merge<VertexHandle>(vertices, affected_vertices);
+	VertexSet vertex_set(vertices.begin(), vertices.end(), scratch);
+	vertex_set.insert(affected_vertices.begin(), affected_vertices.end());
+	vertices.assign(vertex_set.begin(), vertex_set.end());
 }
 
 VertexHandles MotileCell::growFilament(FilamentBranchHandle branch_handle)
@@ -587,10 +962,13 @@ VertexHandles MotileCell::growFilament(FilamentBranchHandle branch_handle)
 	/// one actin monomer to a filament and updating the geometry
 	/// of the local surface of the filament.
 	FilamentBranch& branch = *branch_handle;
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double actin_diameter = strtod(param_table[std::string("actin_diameter")]);
-	bool action = branch.addActin(Actin("ATP", actin_diameter));
+	double actin_diameter = strtod(ParameterTable::lookup("actin_diameter"));
+	// Age the existing monomers before the new ATP monomer is added.
+	branch.ageNucleotides(time_moment, hydrolysis_rate_const, release_rate_const, nucleotide_engine);
+	[[maybe_unused]] bool action = branch.addActin(Actin("ATP", actin_diameter));
 	assert(action);
+	if(cytosol_field != 0) cytosol_field->addMolecules(ReactionDiffusionField::ACTIN, branch.getTailEndLocation(), -1);
+	else exchangeNetworkMolecules(network_species[ReactionDiffusionField::ACTIN], -1);
 	membrane_surface.updateCompositeProperties(branch.getVertex(), true, false);
 	VertexHandles affected_vertices = membrane_surface.updateLocalSurface(branch.getVertex());
 	updateCappedFilamentAttachmentToMembrane(affected_vertices);
@@ -620,9 +998,8 @@ VertexHandles MotileCell::branchFilament(FilamentBranchHandle branch_handle)
 	// geometry.
 	FilamentBranch& branch = *branch_handle;
 	BranchTreeHandle tree_handle = branch.getTreeHandle();
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double actin_diameter = strtod(param_table[std::string("actin_diameter")]);
-	double arp23_diameter = strtod(param_table[std::string("arp23_diameter")]);
+	double actin_diameter = strtod(ParameterTable::lookup("actin_diameter"));
+	double arp23_diameter = strtod(ParameterTable::lookup("arp23_diameter"));
 	// 1) Determine the probability distribution of making a child
 	// filament branch towards the neighboring membrane facets of
 	// its mother filament, by examing the spatial relationship
@@ -632,6 +1009,25 @@ VertexHandles MotileCell::branchFilament(FilamentBranchHandle branch_handle)
 	assert(branch.getChildBranchingFlag());
 	tree_handle->addFilamentBranch(ARP23(0, arp23_diameter), Actin("ATP", actin_diameter), branch.getChildBranchOrient(), branch_handle, tree_handle);
 	FilamentBranchHandle child_branch_handle = tree_handle->getLastBranchHandle();
+	child_branch_handle->setNucleotideTime(time_moment);
+	if(cytosol_field != 0)
+	{
+		// The new branch is nucleated by one ARP23 and a number of
+		// actin monomers taken from the cytosol at its tip.
+		size_t branching_actin_quantity = strtoul(ParameterTable::lookup("branching_actin_quantity"));
+		cytosol_field->addMolecules(ReactionDiffusionField::ARP23, child_branch_handle->getTailEndLocation(), -1);
+		cytosol_field->addMolecules(ReactionDiffusionField::ACTIN, child_branch_handle->getTailEndLocation(), -static_cast<double>(branching_actin_quantity));
+	}
+	else if(network != 0)
+	{
+		// The new branch is nucleated by one activated Arp23 complex
+		// and a number of actin monomers taken from the network.
+		size_t branching_actin_quantity = strtoul(ParameterTable::lookup("branching_actin_quantity"));
+		exchangeNetworkMolecules(network_species[ReactionDiffusionField::ARP23], -1);
+		exchangeNetworkMolecules(network_species[ReactionDiffusionField::ACTIN], -static_cast<long>(branching_actin_quantity));
+		// WASP leaves the complex inactive once the branch is created.
+		exchangeNetworkMolecules(network_wasp, 1);
+	}
 	// Add the child vertex into cell membrane_surface.
 	VertexHandle child_vertex_handle = membrane_surface.addVertex(Vertex(child_branch_handle));
 	VertexHandles affected_vertices = membrane_surface.updateLocalSurface(child_vertex_handle, branch.getChildBranchFacet());
@@ -647,14 +1043,86 @@ VertexHandles MotileCell::capFilament(FilamentBranchHandle branch_handle)
 	/// geometry of the local surface of the filament.
 	FilamentBranch& branch = *branch_handle;
 	VertexHandle vertex_handle = branch.getVertex();
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double cap_diameter = strtod(param_table[std::string("cap_diameter")]);
-	bool action = branch.addCap(CAP(1, cap_diameter));
+	double cap_diameter = strtod(ParameterTable::lookup("cap_diameter"));
+	[[maybe_unused]] bool action = branch.addCap(CAP(1, cap_diameter));
 	assert(action);
+	if(cytosol_field != 0) cytosol_field->addMolecules(ReactionDiffusionField::CAP, branch.getTailEndLocation(), -1);
 	membrane_surface.updateCompositeProperties(vertex_handle, true, true);
 	VertexHandles affected_vertices = membrane_surface.updateLocalSurface(vertex_handle);
 	updateCappedFilamentAttachmentToMembrane(affected_vertices);
 	return affected_vertices;
 }
 
+VertexHandles MotileCell::shrinkFilament(FilamentBranchHandle branch_handle)
+{
+	/// This function executes capped filament shrinking reaction by
+	/// dissociating the actin monomer next to the capping protein and
+	/// updating the geometry of the local surface of the filament.
+	/// Since ADF only dissociates an ADP-actin monomer, the reaction
+	/// has no effect while this monomer still holds ATP or ADP-Pi, or
+	/// while the reaction network has run out of ADF since the rate
+	/// was evaluated.
+	FilamentBranch& branch = *branch_handle;
+	branch.ageNucleotides(time_moment, hydrolysis_rate_const, release_rate_const, nucleotide_engine);
+	VertexHandles affected_vertices;
+	if(std::string(branch.getFilament().back().getState()) == "ADP" && isNetworkAdfAvailable())
+	{
+		VertexHandle vertex_handle = branch.getVertex();
+		branch.removeActin();
+		if(cytosol_field != 0) cytosol_field->addMolecules(ReactionDiffusionField::ACTIN, branch.getTailEndLocation(), 1);
+		else
+		{
+			// ADF leaves with the dissociated monomer as ADP-actin-ADF.
+			exchangeNetworkMolecules(network_adf, -1);
+			exchangeNetworkMolecules(network_adp_adf, 1);
+		}
+		membrane_surface.updateCompositeProperties(vertex_handle, true, false);
+		affected_vertices = membrane_surface.updateLocalSurface(vertex_handle);
+		updateCappedFilamentAttachmentToMembrane(affected_vertices);
+	}
+	return affected_vertices;
+}
+
+VertexHandles MotileCell::severFilament(FilamentBranchHandle branch_handle)
+{
+	/// This function executes filament severing reaction:
+	///
+	/// 1) Sample the severing site uniformly among the sites bounding
+	/// the rate, and accept it only if it holds ADP-actin. The ADP-actin
+	/// monomers are the oldest monomers of the filament.
+	///
+	/// 2) Detach the filament from its vertex, which is removed from
+	/// membrane surface, and destroy the reactions of the filament.
+	///
+	/// 3) Split the filament. The distal part becomes the root of a
+	/// new filament tree holding the child filaments located on it,
+	/// or is released into cytosol if it holds no child filament.
+	///
+	/// 4) Remove the proximal part if it holds no child filament.
+	FilamentBranch& branch = *branch_handle;
+	branch.ageNucleotides(time_moment, hydrolysis_rate_const, release_rate_const, nucleotide_engine);
+	VertexHandles affected_vertices;
+	size_t bound_site_num = branch.length() - 1;
+	size_t site_num = branch.getFilament().countState(2);
+	if(site_num > bound_site_num) site_num = bound_site_num;
+	// The uniform probability may be exactly one, which would select a
+	// site beyond the bound.
+	size_t k = std::min(1 + static_cast<size_t>(getUniformProbability() * bound_site_num), bound_site_num);
+	if(k > site_num || !isNetworkAdfAvailable()) return affected_vertices;
+	discardFilamentReactions(branch_handle);
+	affected_vertices = membrane_surface.removeVertex(branch.getVertex());
+	BranchTreeHandle tree_handle = branch.getTreeHandle();
+	filament_network.emplace_back();
+	BranchTreeHandle new_tree_handle = --(filament_network.end());
+	tree_handle->severFilamentBranch(branch_handle, k, new_tree_handle);
+	if(new_tree_handle->getBranches().size() == 1)
+	{
+		releaseFilamentMolecules(new_tree_handle->getBranches().begin());
+		filament_network.erase(new_tree_handle);
+	}
+	if(branch.sizeofChildHandles() == 0) removeFilament(branch_handle);
+	updateCappedFilamentAttachmentToMembrane(affected_vertices);
+	return affected_vertices;
+}
+
 }
@@ -0,0 +1,53 @@
+#include <cassert>
+#include <NetworkReaction.hpp>
+
+namespace motility
+{
+
+NetworkReaction::NetworkReaction(ReactionNetwork* n, size_t c) : simulation::DiscreteEvent()
+{
+	assert(c < n->getChannelNumber());
+	network = n;
+	channel = c;
+	leap_period = 0;
+	engine = 0;
+	update();
+}
+
+NetworkReaction::NetworkReaction(ReactionNetwork* n, double tau, std::mt19937* e) : simulation::DiscreteEvent()
+{
+	assert(tau > 0 && e != 0);
+	network = n;
+	channel = 0;
+	leap_period = tau;
+	engine = e;
+	update();
+}
+
+NetworkReaction::~NetworkReaction() throw() {}
+
+size_t NetworkReaction::getChannel() const
+{
+	return channel;
+}
+
+bool NetworkReaction::isLeaping() const
+{
+	return leap_period > 0;
+}
+
+double NetworkReaction::compute_rate()
+{
+	double r;
+	if(isLeaping()) r = 1 / leap_period;
+	else r = network->getPropensity(channel);
+	return r;
+}
+
+void NetworkReaction::action()
+{
+	if(isLeaping()) network->leap(leap_period, *engine);
+	else network->fire(channel);
+}
+
+}
@@ -0,0 +1,125 @@
+#include <cassert>
+#include <cmath>
+#include <NonUniformMolecularDistribution.hpp>
+
+namespace motility
+{
+
+namespace
+{
+
+// This function returns the number of grid points covering a range with
+// a given maximum spacing.
+size_t getGridPointNumber(double range, double spacing)
+{
+	if(range <= 0) return 1;
+	return static_cast<size_t>(std::ceil(range / spacing)) + 1;
+}
+
+}
+
+NonUniformMolecularDistribution::NonUniformMolecularDistribution(const SpatialBoundary& bound, const MolecularDistributionFunction& func, double spacing) : MolecularDistribution(bound, NON_UNIFORM)
+{
+	assert(spacing > 0);
+	nx = getGridPointNumber(boundary.getXRange(), spacing);
+	ny = getGridPointNumber(boundary.getYRange(), spacing);
+	nz = getGridPointNumber(boundary.getZRange(), spacing);
+	bx = (nx + brick_size - 1) / brick_size;
+	by = (ny + brick_size - 1) / brick_size;
+	bz = (nz + brick_size - 1) / brick_size;
+	x0 = boundary.getXmin();
+	y0 = boundary.getYmin();
+	z0 = boundary.getZmin();
+	// The grid points are spread evenly such that the first and the last
+	// ones lie on the boundary.
+	double hx = (nx > 1 ? boundary.getXRange() / (nx - 1) : 0);
+	double hy = (ny > 1 ? boundary.getYRange() / (ny - 1) : 0);
+	double hz = (nz > 1 ? boundary.getZRange() / (nz - 1) : 0);
+	inv_hx = (nx > 1 ? 1 / hx : 0);
+	inv_hy = (ny > 1 ? 1 / hy : 0);
+	inv_hz = (nz > 1 ? 1 / hz : 0);
+	// The grid points of partial bricks beyond the boundary are never
+	// read and stay zero.
+	densities.assign(bx * by * bz * brick_size * brick_size * brick_size, 0);
+	const long n_layer = static_cast<long>(nz);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(long k = 0; k < n_layer; ++k)
+	{
+		for(size_t j = 0; j < ny; ++j)
+		{
+			for(size_t i = 0; i < nx; ++i)
+			{
+				CartesianCoordinate loc(x0 + i * hx, y0 + j * hy, z0 + k * hz);
+				densities[getIndex(i, j, k)] = func(loc);
+			}
+		}
+	}
+}
+
+inline size_t NonUniformMolecularDistribution::getIndex(size_t i, size_t j, size_t k) const
+{
+	size_t brick = ((k / brick_size) * by + j / brick_size) * bx + i / brick_size;
+	size_t offset = ((k % brick_size) * brick_size + j % brick_size) * brick_size + i % brick_size;
+	return brick * (brick_size * brick_size * brick_size) + offset;
+}
+
+inline double NonUniformMolecularDistribution::interpolate(double x, double y, double z) const
+{
+	double fx = (x - x0) * inv_hx;
+	double fy = (y - y0) * inv_hy;
+	double fz = (z - z0) * inv_hz;
+	// The lower grid point of each axis is clamped such that a location
+	// on the upper boundary is interpolated within the last cell.
+	size_t i0 = static_cast<size_t>(fx);
+	size_t j0 = static_cast<size_t>(fy);
+	size_t k0 = static_cast<size_t>(fz);
+	i0 = (i0 + 1 < nx ? i0 : (nx > 1 ? nx - 2 : 0));
+	j0 = (j0 + 1 < ny ? j0 : (ny > 1 ? ny - 2 : 0));
+	k0 = (k0 + 1 < nz ? k0 : (nz > 1 ? nz - 2 : 0));
+	size_t i1 = (nx > 1 ? i0 + 1 : i0);
+	size_t j1 = (ny > 1 ? j0 + 1 : j0);
+	size_t k1 = (nz > 1 ? k0 + 1 : k0);
+	double tx = fx - i0, ty = fy - j0, tz = fz - k0;
+	double c00 = densities[getIndex(i0, j0, k0)] * (1 - tx) + densities[getIndex(i1, j0, k0)] * tx;
+	double c10 = densities[getIndex(i0, j1, k0)] * (1 - tx) + densities[getIndex(i1, j1, k0)] * tx;
+	double c01 = densities[getIndex(i0, j0, k1)] * (1 - tx) + densities[getIndex(i1, j0, k1)] * tx;
+	double c11 = densities[getIndex(i0, j1, k1)] * (1 - tx) + densities[getIndex(i1, j1, k1)] * tx;
+	double c0 = c00 * (1 - ty) + c10 * ty;
+	double c1 = c01 * (1 - ty) + c11 * ty;
+	return c0 * (1 - tz) + c1 * tz;
+}
+
+double NonUniformMolecularDistribution::getDensity(const CartesianCoordinate& loc)
+{
+	double dens;
+	if(boundary.isInside(loc)) dens = interpolate(loc.x, loc.y, loc.z);
+	else dens = 0;
+	return dens;
+}
+
+void NonUniformMolecularDistribution::getDensities(const CartesianCoordinate* locs, size_t n, double* dens)
+{
+	// The locations outside the boundary are clamped onto it so that
+	// every lane of the loop follows the same path, and their densities
+	// are masked out afterwards.
+	const double x_min = boundary.getXmin(), x_max = boundary.getXmax();
+	const double y_min = boundary.getYmin(), y_max = boundary.getYmax();
+	const double z_min = boundary.getZmin(), z_max = boundary.getZmax();
+#ifdef _OPENMP
+	#pragma omp simd
+#endif
+	for(size_t i = 0; i < n; ++i)
+	{
+		double x = locs[i].x, y = locs[i].y, z = locs[i].z;
+		bool inside = (x_min <= x && x <= x_max && y_min <= y && y <= y_max && z_min <= z && z <= z_max);
+		x = std::fmin(std::fmax(x, x_min), x_max);
+		y = std::fmin(std::fmax(y, y_min), y_max);
+		z = std::fmin(std::fmax(z, z_min), z_max);
+		double d = interpolate(x, y, z);
+		dens[i] = (inside ? d : 0);
+	}
+}
+
+}
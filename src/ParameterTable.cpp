@@ -1,4 +1,5 @@
 #include <ParameterTable.hpp>
+#include <algorithms.hpp>
 
 namespace motility
 {
@@ -13,4 +14,12 @@ std::map<std::string, std::string>& ParameterTable::instance()
 	return pt.table;
 }
 
+const std::string& ParameterTable::lookup(const std::string& name)
+{
+	const Table& param_table = instance();
+	Table::const_iterator param_ptr = param_table.find(name);
+	if(param_ptr == param_table.end()) handleErrorEvent("The parameter '" + name + "' is not defined in the parameter file");
+	return param_ptr->second;
+}
+
 }
@@ -0,0 +1,157 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <FilamentStateTable.hpp>
+#include <ReactionDiffusionField.hpp>
+
+namespace motility
+{
+
+namespace
+{
+
+// The number of molecules per um^3 at the concentration of 1 uM.
+const double molecules_per_um3_uM = 602.214;
+
+// The fraction of the stability limit of the explicit scheme used as
+// the time step of a sub-cycle.
+const double stability_safety = 0.9;
+
+// This function returns the number of voxels covering a range with a
+// given maximum voxel size.
+size_t getVoxelNumber(double range, double spacing)
+{
+	if(range <= 0) return 1;
+	return static_cast<size_t>(std::ceil(range / spacing));
+}
+
+}
+
+ReactionDiffusionField::ReactionDiffusionField(const SpatialBoundary& bound, double spacing, double coef, const double* initial_concs)
+{
+	assert(spacing > 0 && coef >= 0);
+	boundary = bound;
+	nx = getVoxelNumber(boundary.getXRange(), spacing);
+	ny = getVoxelNumber(boundary.getYRange(), spacing);
+	nz = getVoxelNumber(boundary.getZRange(), spacing);
+	hx = (boundary.getXRange() > 0 ? boundary.getXRange() / nx : spacing);
+	hy = (boundary.getYRange() > 0 ? boundary.getYRange() / ny : spacing);
+	hz = (boundary.getZRange() > 0 ? boundary.getZRange() / nz : spacing);
+	diffusion_coef = coef;
+	molecule_conc = 1 / (molecules_per_um3_uM * hx * hy * hz);
+	for(size_t s = 0; s < SPECIES_NUM; ++s) concs[s].assign(nx * ny * nz, initial_concs[s]);
+	next_concs.resize(nx * ny * nz);
+	stamp = 1;
+}
+
+size_t ReactionDiffusionField::getVoxelIndex(const CartesianCoordinate& loc) const
+{
+	double x = (loc.x - boundary.getXmin()) / hx;
+	double y = (loc.y - boundary.getYmin()) / hy;
+	double z = (loc.z - boundary.getZmin()) / hz;
+	size_t i = (x > 0 ? static_cast<size_t>(x) : 0);
+	size_t j = (y > 0 ? static_cast<size_t>(y) : 0);
+	size_t k = (z > 0 ? static_cast<size_t>(z) : 0);
+	// A location on or beyond the upper boundary belongs to the last
+	// voxel, and one below the lower boundary to the first voxel.
+	if(i >= nx) i = nx - 1;
+	if(j >= ny) j = ny - 1;
+	if(k >= nz) k = nz - 1;
+	return (k * ny + j) * nx + i;
+}
+
+double ReactionDiffusionField::getConcentration(Species s, const CartesianCoordinate& loc) const
+{
+	// A voxel in deficit holds no molecule for the reactions.
+	double conc;
+	if(boundary.isInside(loc)) conc = std::max(concs[s][getVoxelIndex(loc)], 0.0);
+	else conc = 0;
+	return conc;
+}
+
+double ReactionDiffusionField::getTipConcentration(Species s, const FilamentBranch& branch)
+{
+	size_t id = branch.getId();
+	// The filaments created after the latest update are sampled
+	// directly. The cache is only resized by the update, since the
+	// rates of different filaments may be evaluated in parallel.
+	if(id >= tip_samples.size()) return getConcentration(s, branch.getTailEndLocation());
+	size_t generation = FilamentStateTable::instance().getFilamentId(id).generation;
+	TipSample& sample = tip_samples[id];
+	if(sample.stamp != stamp || sample.generation != generation)
+	{
+		CartesianCoordinate tip = branch.getTailEndLocation();
+		for(size_t t = 0; t < SPECIES_NUM; ++t) sample.concs[t] = getConcentration(static_cast<Species>(t), tip);
+		sample.stamp = stamp;
+		sample.generation = generation;
+	}
+	return sample.concs[s];
+}
+
+void ReactionDiffusionField::addMolecules(Species s, const CartesianCoordinate& loc, double n)
+{
+	concs[s][getVoxelIndex(loc)] += n * molecule_conc;
+}
+
+void ReactionDiffusionField::diffuse(std::vector<double>& conc, double dt)
+{
+	const double cx = (nx > 1 ? diffusion_coef * dt / (hx * hx) : 0);
+	const double cy = (ny > 1 ? diffusion_coef * dt / (hy * hy) : 0);
+	const double cz = (nz > 1 ? diffusion_coef * dt / (hz * hz) : 0);
+	const double* c = conc.data();
+	double* c_next = next_concs.data();
+	const long n_row = static_cast<long>(ny * nz);
+	// Each row along x is updated by one thread. The zero-flux boundary
+	// is imposed by mirroring the voxels on the boundary, i.e. a missing
+	// neighbor is replaced by the voxel itself.
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(long row = 0; row < n_row; ++row)
+	{
+		size_t j = static_cast<size_t>(row) % ny;
+		size_t k = static_cast<size_t>(row) / ny;
+		const double* r = c + (k * ny + j) * nx;
+		const double* r_ym = c + (k * ny + (j > 0 ? j - 1 : j)) * nx;
+		const double* r_yp = c + (k * ny + (j + 1 < ny ? j + 1 : j)) * nx;
+		const double* r_zm = c + ((k > 0 ? k - 1 : k) * ny + j) * nx;
+		const double* r_zp = c + ((k + 1 < nz ? k + 1 : k) * ny + j) * nx;
+		double* r_next = c_next + (k * ny + j) * nx;
+#ifdef _OPENMP
+		#pragma omp simd
+#endif
+		for(size_t i = 0; i < nx; ++i)
+		{
+			double xm = r[i > 0 ? i - 1 : i];
+			double xp = r[i + 1 < nx ? i + 1 : i];
+			r_next[i] = r[i] + cx * (xm + xp - 2 * r[i]) + cy * (r_ym[i] + r_yp[i] - 2 * r[i]) + cz * (r_zm[i] + r_zp[i] - 2 * r[i]);
+		}
+	}
+	conc.swap(next_concs);
+}
+
+void ReactionDiffusionField::advance(double period)
+{
+	if(period > 0 && diffusion_coef > 0)
+	{
+		// The explicit scheme is stable if D*dt*(1/hx^2+1/hy^2+1/hz^2)
+		// does not exceed 1/2.
+		double inv_h2 = (nx > 1 ? 1 / (hx * hx) : 0) + (ny > 1 ? 1 / (hy * hy) : 0) + (nz > 1 ? 1 / (hz * hz) : 0);
+		if(inv_h2 > 0)
+		{
+			double max_dt = stability_safety / (2 * diffusion_coef * inv_h2);
+			size_t n_cycle = static_cast<size_t>(std::ceil(period / max_dt));
+			double dt = period / n_cycle;
+			for(size_t s = 0; s < SPECIES_NUM; ++s)
+			{
+				for(size_t n = 0; n < n_cycle; ++n) diffuse(concs[s], dt);
+			}
+		}
+	}
+	// Invalidate all cached tip samples and make room for the filaments
+	// created since the last update.
+	tip_samples.resize(FilamentStateTable::instance().size(), TipSample());
+	++stamp;
+}
+
+}
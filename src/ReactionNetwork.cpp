@@ -0,0 +1,292 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <ReactionTypeTable.hpp>
+#include <ReactionNetwork.hpp>
+#ifdef COMPILED_REACTION_NETWORK
+#include <ReactionNetworkKernels.hpp>
+#endif
+
+namespace motility
+{
+
+ReactionNetwork::ReactionNetwork(const std::vector<std::string>& compartments, double vol)
+{
+	assert(vol > 0);
+	volume = vol;
+	ReactionTypeTable::Table& reac_table = ReactionTypeTable::instance();
+	for(ReactionTypeTable::Table::const_iterator it = reac_table.begin(); it != reac_table.end(); ++it)
+	{
+		const ReactionTypeTable::ReactionType& rt = it->second;
+		if(std::find(compartments.begin(), compartments.end(), rt.compartment) == compartments.end()) continue;
+		std::vector<size_t> reactants, products;
+		for(std::list<std::string>::const_iterator sit = rt.reactants.begin(); sit != rt.reactants.end(); ++sit) reactants.push_back(addSpecies(*sit));
+		for(std::list<std::string>::const_iterator sit = rt.products.begin(); sit != rt.products.end(); ++sit) products.push_back(addSpecies(*sit));
+		if(rt.forward_const > 0) addChannel(reactants, products, rt.forward_const);
+		if(rt.backward_const > 0) addChannel(products, reactants, rt.backward_const);
+	}
+	counts.assign(species_names.size(), 0);
+	/// The dependency graph is stored in compressed rows. Each channel
+	/// is listed once under every distinct species of its reactants.
+	std::vector<size_t> dependent_counts(species_names.size(), 0);
+	for(size_t c = 0; c < channels.size(); ++c)
+	{
+		for(size_t r = channels[c].reactant_begin; r < channels[c].reactant_end; ++r)
+		{
+			if(r == channels[c].reactant_begin || reactant_species[r] != reactant_species[r - 1]) ++dependent_counts[reactant_species[r]];
+		}
+	}
+	dependent_offsets.assign(species_names.size() + 1, 0);
+	for(size_t i = 0; i < species_names.size(); ++i) dependent_offsets[i + 1] = dependent_offsets[i] + dependent_counts[i];
+	dependents.resize(dependent_offsets.back());
+	std::vector<size_t> positions(dependent_offsets.begin(), dependent_offsets.end() - 1);
+	for(size_t c = 0; c < channels.size(); ++c)
+	{
+		for(size_t r = channels[c].reactant_begin; r < channels[c].reactant_end; ++r)
+		{
+			if(r == channels[c].reactant_begin || reactant_species[r] != reactant_species[r - 1]) dependents[positions[reactant_species[r]]++] = c;
+		}
+	}
+	leap_propensities.resize(channels.size());
+	leap_firings.resize(channels.size());
+	compiled = false;
+#ifdef COMPILED_REACTION_NETWORK
+	// The kernels are only used if the reaction file read at run time
+	// compiles to the same species and stoichiometry as the one read
+	// at build time, and to the same propensities at distinct counts
+	// of all species, which tells apart the reactants.
+	bool match = (species_names.size() == kernels::species_num && channels.size() == kernels::channel_num);
+	for(size_t i = 0; match && i < species_names.size(); ++i) match = (species_names[i] == kernels::species_names[i]);
+	for(size_t c = 0; match && c < channels.size(); ++c)
+	{
+		std::vector<long> changes(species_names.size(), 0);
+		for(size_t i = channels[c].change_begin; i < channels[c].change_end; ++i) changes[change_species[i]] = change_amounts[i];
+		for(size_t i = 0; match && i < species_names.size(); ++i) match = (changes[i] == kernels::stoichiometry[c][i]);
+	}
+	for(size_t i = 0; i < counts.size(); ++i) counts[i] = static_cast<long>(i) + 3;
+	for(size_t c = 0; match && c < channels.size(); ++c)
+	{
+		double a = getPropensity(c);
+		match = (std::fabs(kernels::propensity(c, rate_consts.data(), counts.data()) - a) <= 1e-12 * a);
+	}
+	counts.assign(species_names.size(), 0);
+	if(!match) std::cout << "The reaction network differs from the one compiled at build time and is interpreted." << std::endl;
+	compiled = match;
+#endif
+}
+
+size_t ReactionNetwork::addSpecies(const std::string& name)
+{
+	size_t i = getSpeciesIndex(name);
+	if(i == species_null)
+	{
+		i = species_names.size();
+		species_names.push_back(name);
+	}
+	return i;
+}
+
+void ReactionNetwork::addChannel(const std::vector<size_t>& reactants, const std::vector<size_t>& products, double rate_const)
+{
+	Channel channel;
+	// A reaction of order n has a rate constant in uM^(1-n)/s, which
+	// is converted into molecule counts in the volume.
+	double molecules_per_uM = molecules_per_um3_uM * volume;
+	rate_consts.push_back(rate_const * std::pow(molecules_per_uM, 1 - static_cast<double>(reactants.size())));
+	channel.reactant_begin = reactant_species.size();
+	std::vector<size_t> sorted_reactants(reactants);
+	std::sort(sorted_reactants.begin(), sorted_reactants.end());
+	reactant_species.insert(reactant_species.end(), sorted_reactants.begin(), sorted_reactants.end());
+	channel.reactant_end = reactant_species.size();
+	// Merge the consumption and the production of each species into
+	// its net change.
+	channel.change_begin = change_species.size();
+	std::vector<long> changes(species_names.size(), 0);
+	for(size_t r = 0; r < reactants.size(); ++r) --changes[reactants[r]];
+	for(size_t p = 0; p < products.size(); ++p) ++changes[products[p]];
+	for(size_t i = 0; i < changes.size(); ++i)
+	{
+		if(changes[i] != 0)
+		{
+			change_species.push_back(i);
+			change_amounts.push_back(changes[i]);
+		}
+	}
+	channel.change_end = change_species.size();
+	channels.push_back(channel);
+}
+
+size_t ReactionNetwork::getSpeciesNumber() const
+{
+	return species_names.size();
+}
+
+size_t ReactionNetwork::getChannelNumber() const
+{
+	return channels.size();
+}
+
+bool ReactionNetwork::isCompiled() const
+{
+	return compiled;
+}
+
+size_t ReactionNetwork::getSpeciesIndex(const std::string& name) const
+{
+	std::vector<std::string>::const_iterator it = std::find(species_names.begin(), species_names.end(), name);
+	if(it == species_names.end()) return species_null;
+	return static_cast<size_t>(it - species_names.begin());
+}
+
+const std::string& ReactionNetwork::getSpeciesName(size_t i) const
+{
+	assert(i < species_names.size());
+	return species_names[i];
+}
+
+long ReactionNetwork::getCount(size_t i) const
+{
+	assert(i < counts.size());
+	return counts[i];
+}
+
+double ReactionNetwork::getConcentration(size_t i) const
+{
+	assert(i < counts.size());
+	return counts[i] / (molecules_per_um3_uM * volume);
+}
+
+void ReactionNetwork::setConcentration(size_t i, double conc)
+{
+	assert(i < counts.size() && conc >= 0);
+	counts[i] = std::lround(conc * molecules_per_um3_uM * volume);
+}
+
+void ReactionNetwork::addMolecules(size_t i, long n)
+{
+	assert(i < counts.size());
+	counts[i] += n;
+	if(counts[i] < 0) counts[i] = 0;
+}
+
+double ReactionNetwork::getPropensity(size_t c) const
+{
+	assert(c < channels.size());
+#ifdef COMPILED_REACTION_NETWORK
+	if(compiled) return kernels::propensity(c, rate_consts.data(), counts.data());
+#endif
+	const Channel& channel = channels[c];
+	double a = rate_consts[c];
+	// The m-th copy of a repeated reactant is chosen among the count
+	// of the species less the m copies chosen before.
+	long m = 0;
+	for(size_t r = channel.reactant_begin; r < channel.reactant_end && a > 0; ++r)
+	{
+		if(r > channel.reactant_begin && reactant_species[r] == reactant_species[r - 1]) ++m;
+		else m = 0;
+		long n = counts[reactant_species[r]] - m;
+		a = (n > 0 ? a * n : 0);
+	}
+	return a;
+}
+
+void ReactionNetwork::fire(size_t c)
+{
+	assert(c < channels.size());
+#ifdef COMPILED_REACTION_NETWORK
+	// A channel with a positive propensity never consumes more
+	// molecules than there are.
+	if(compiled)
+	{
+		kernels::fire(c, counts.data());
+		return;
+	}
+#endif
+	const Channel& channel = channels[c];
+	for(size_t i = channel.change_begin; i < channel.change_end; ++i)
+	{
+		long& n = counts[change_species[i]];
+		n += change_amounts[i];
+		if(n < 0) n = 0;
+	}
+}
+
+void ReactionNetwork::computePropensities(double* a) const
+{
+#ifdef COMPILED_REACTION_NETWORK
+	if(compiled)
+	{
+		kernels::propensities(rate_consts.data(), counts.data(), a);
+		return;
+	}
+#endif
+	for(size_t c = 0; c < channels.size(); ++c) a[c] = getPropensity(c);
+}
+
+void ReactionNetwork::fire(const long* firings)
+{
+#ifdef COMPILED_REACTION_NETWORK
+	if(compiled)
+	{
+		kernels::fire(firings, counts.data());
+		return;
+	}
+#endif
+	for(size_t c = 0; c < channels.size(); ++c)
+	{
+		if(firings[c] == 0) continue;
+		const Channel& channel = channels[c];
+		for(size_t i = channel.change_begin; i < channel.change_end; ++i) counts[change_species[i]] += firings[c] * change_amounts[i];
+	}
+}
+
+void ReactionNetwork::leap(double tau, std::mt19937& engine)
+{
+	// All propensities are evaluated before any channel fires, as the
+	// counts are frozen during a leap.
+	computePropensities(leap_propensities.data());
+	for(size_t c = 0; c < channels.size(); ++c)
+	{
+		long k = 0;
+		if(leap_propensities[c] > 0)
+		{
+			std::poisson_distribution<long> firing(leap_propensities[c] * tau);
+			k = firing(engine);
+		}
+		leap_firings[c] = k;
+	}
+	fire(leap_firings.data());
+	for(size_t i = 0; i < counts.size(); ++i)
+	{
+		if(counts[i] < 0) counts[i] = 0;
+	}
+}
+
+const size_t* ReactionNetwork::beginDependents(size_t i) const
+{
+	assert(i < species_names.size());
+	return dependents.data() + dependent_offsets[i];
+}
+
+const size_t* ReactionNetwork::endDependents(size_t i) const
+{
+	assert(i < species_names.size());
+	return dependents.data() + dependent_offsets[i + 1];
+}
+
+void ReactionNetwork::getAffectedChannels(size_t c, std::vector<size_t>& affected) const
+{
+	assert(c < channels.size());
+	const Channel& channel = channels[c];
+	affected.clear();
+	for(size_t i = channel.change_begin; i < channel.change_end; ++i)
+	{
+		for(const size_t* d = beginDependents(change_species[i]); d != endDependents(change_species[i]); ++d)
+		{
+			if(std::find(affected.begin(), affected.end(), *d) == affected.end()) affected.push_back(*d);
+		}
+	}
+}
+
+}
@@ -1,4 +1,5 @@
 #include <ReactionTypeTable.hpp>
+#include <algorithms.hpp>
 
 namespace motility
 {
@@ -17,6 +18,7 @@ void ReactionTypeTable::ReactionType::clear()
 	products.clear();
 	forward_const = 0;
 	backward_const = 0;
+	compartment.clear();
 }
 
 ReactionTypeTable::Table& ReactionTypeTable::instance()
@@ -25,4 +27,12 @@ ReactionTypeTable::Table& ReactionTypeTable::instance()
 	return rtt.table;
 }
 
+const ReactionTypeTable::ReactionType& ReactionTypeTable::lookup(const std::string& name)
+{
+	const Table& reac_table = instance();
+	Table::const_iterator reac_ptr = reac_table.find(name);
+	if(reac_ptr == reac_table.end()) handleErrorEvent("The reaction type '" + name + "' is not defined in the reaction file");
+	return reac_ptr->second;
+}
+
 }
@@ -0,0 +1,161 @@
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <SubstratePatternDistribution.hpp>
+#include <algorithms.hpp>
+
+namespace motility
+{
+
+namespace
+{
+
+// This function skips the whitespaces and the comments of a PGM header,
+// and returns whether or not the end of the header is reached.
+bool skipPgmSpaces(const unsigned char* data, size_t size, size_t& pos)
+{
+	while(pos < size)
+	{
+		if(data[pos] == '#')
+		{
+			while(pos < size && data[pos] != '\n') ++pos;
+		}
+		else if(std::isspace(data[pos])) ++pos;
+		else break;
+	}
+	return pos >= size;
+}
+
+// This function reads a decimal number of a PGM header, and returns zero
+// if there is no number.
+size_t readPgmNumber(const unsigned char* data, size_t size, size_t& pos)
+{
+	size_t number = 0;
+	if(skipPgmSpaces(data, size, pos)) return 0;
+	while(pos < size && std::isdigit(data[pos])) number = number * 10 + (data[pos++] - '0');
+	return number;
+}
+
+}
+
+SubstratePatternDistribution::SubstratePatternDistribution(const SpatialBoundary& bound, const std::string& filename, double dens, size_t raw_width, size_t raw_height) : MolecularDistribution(bound, SUBSTRATE_PATTERN)
+{
+	load(filename, raw_width, raw_height);
+	x0 = boundary.getXmin();
+	y0 = boundary.getYmin();
+	inv_px = (boundary.getXRange() > 0 ? width / boundary.getXRange() : 0);
+	inv_py = (boundary.getYRange() > 0 ? height / boundary.getYRange() : 0);
+	for(size_t l = 0; l < 256; ++l) level_densities[l] = dens * l / 255;
+}
+
+void SubstratePatternDistribution::load(const std::string& filename, size_t raw_width, size_t raw_height)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd < 0) handleErrorEvent("cannot open the pattern file " + filename);
+	struct stat file_stat;
+	if(fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		close(fd);
+		handleErrorEvent("cannot read the pattern file " + filename);
+	}
+	size_t size = static_cast<size_t>(file_stat.st_size);
+	void* mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(mapping == MAP_FAILED) handleErrorEvent("cannot map the pattern file " + filename);
+	const unsigned char* data = static_cast<const unsigned char*>(mapping);
+	// A PGM image starts with its magic number, and its size and maximum
+	// gray level are given in the header. Otherwise the file is a raw
+	// bitmap of one byte per pixel.
+	size_t pos = 0, max_level = 255, bytes_per_pixel = 1;
+	if(size > 2 && data[0] == 'P' && data[1] == '5')
+	{
+		pos = 2;
+		width = readPgmNumber(data, size, pos);
+		height = readPgmNumber(data, size, pos);
+		max_level = readPgmNumber(data, size, pos);
+		// A single whitespace separates the header from the pixels.
+		++pos;
+		if(max_level > 255) bytes_per_pixel = 2;
+	}
+	else
+	{
+		width = raw_width;
+		height = raw_height;
+	}
+	if(width == 0 || height == 0 || max_level == 0 || max_level > 65535 || pos + width * height * bytes_per_pixel > size)
+	{
+		munmap(mapping, size);
+		handleErrorEvent("the pattern file " + filename + " is not a binary PGM image or a raw bitmap of the given size");
+	}
+	tiles_x = (width + tile_size - 1) / tile_size;
+	size_t tiles_y = (height + tile_size - 1) / tile_size;
+	levels.assign(tiles_x * tiles_y * tile_size * tile_size, 0);
+	// The gray levels are rescaled to 8 bits, with the 16-bit ones
+	// stored in big-endian order.
+	const unsigned char* pixels = data + pos;
+	for(size_t j = 0; j < height; ++j)
+	{
+		for(size_t i = 0; i < width; ++i)
+		{
+			size_t p = j * width + i;
+			size_t level = (bytes_per_pixel == 1 ? pixels[p] : (static_cast<size_t>(pixels[2 * p]) << 8) | pixels[2 * p + 1]);
+			if(level > max_level) level = max_level;
+			levels[getIndex(i, j)] = static_cast<unsigned char>((level * 255 + max_level / 2) / max_level);
+		}
+	}
+	munmap(mapping, size);
+}
+
+inline size_t SubstratePatternDistribution::getIndex(size_t i, size_t j) const
+{
+	size_t tile = (j / tile_size) * tiles_x + i / tile_size;
+	size_t offset = (j % tile_size) * tile_size + i % tile_size;
+	return tile * (tile_size * tile_size) + offset;
+}
+
+inline double SubstratePatternDistribution::lookup(double x, double y) const
+{
+	// The pixel on the upper boundary of each axis is clamped into the
+	// image, and the rows run from the maximum y downwards.
+	size_t i = static_cast<size_t>((x - x0) * inv_px);
+	size_t j = static_cast<size_t>((y - y0) * inv_py);
+	i = (i < width ? i : width - 1);
+	j = (j < height ? j : height - 1);
+	return level_densities[levels[getIndex(i, height - 1 - j)]];
+}
+
+double SubstratePatternDistribution::getDensity(const CartesianCoordinate& loc)
+{
+	double dens;
+	if(boundary.isInside(loc)) dens = lookup(loc.x, loc.y);
+	else dens = 0;
+	return dens;
+}
+
+void SubstratePatternDistribution::getDensities(const CartesianCoordinate* locs, size_t n, double* dens)
+{
+	// The locations outside the boundary are clamped onto it so that
+	// every lane of the loop follows the same path, and their densities
+	// are masked out afterwards.
+	const double x_min = boundary.getXmin(), x_max = boundary.getXmax();
+	const double y_min = boundary.getYmin(), y_max = boundary.getYmax();
+	const double z_min = boundary.getZmin(), z_max = boundary.getZmax();
+#ifdef _OPENMP
+	#pragma omp simd
+#endif
+	for(size_t i = 0; i < n; ++i)
+	{
+		double x = locs[i].x, y = locs[i].y, z = locs[i].z;
+		bool inside = (x_min <= x && x <= x_max && y_min <= y && y <= y_max && z_min <= z && z <= z_max);
+		x = std::fmin(std::fmax(x, x_min), x_max);
+		y = std::fmin(std::fmax(y, y_min), y_max);
+		double d = lookup(x, y);
+		dens[i] = (inside ? d : 0);
+	}
+}
+
+}
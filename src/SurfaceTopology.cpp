@@ -2,14 +2,23 @@
 #include <cfloat>
 #include <fstream>
 #include <sstream>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <algorithm>
 #include <SurfaceTopology.hpp>
 #include <constants.hpp>
 #include <FilamentBranch.hpp>
+#include <FilamentStateTable.hpp>
 #include <Vector.hpp>
 #include <Line.hpp>
 #include <Triangle.hpp>
 #include <ParameterTable.hpp>
 #include <algorithms.hpp>
+#include <MemoryArena.hpp>
+#include <mathKernels.hpp>
+#include <invariants.hpp>
 
 namespace motility
 {
@@ -18,6 +27,10 @@ SurfaceTopology::SurfaceTopology()
 {
 	n_uncapped_vertex = 0;
 	area = 0;
+	// The global search is off unless the parameter file enables it.
+	ParameterTable::Table& param_table = ParameterTable::instance();
+	ParameterTable::Table::const_iterator param_ptr = param_table.find("global_facet_search");
+	global_facet_search_flag = (param_ptr != param_table.end() && strtob(param_ptr->second));
 }
 
 SurfaceTopology::~SurfaceTopology() {}
@@ -126,7 +139,10 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle vertex_handle)
 
 	VertexHandles affected_vertices = getNeighboringVertexHandles(vertex_handle);
 	CartesianCoordinate vertex_location = vertex_handle->getLocation();
-	EdgeHandles vertex_edges = vertex_handle->edges;
+	// The temporary lists of this function are drawn from the scratch
+	// arena of current simulation step.
+	std::pmr::memory_resource* scratch = simulation::MemoryArena::instance().scratch();
+	EdgeHandles vertex_edges(vertex_handle->edges, scratch);
 	EdgeHandles::reverse_iterator ehh = vertex_edges.rbegin();
 	while(ehh != vertex_edges.rend())
 	{
@@ -152,9 +168,19 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle vertex_handle)
 				VertexHandle vh4 = prev_dual->next->vertex;
 				// Step #4: Check whether the vertex V1 and V4 are connected.
 				// Step 4.1 Check if there is an edge from v4 to v1.
-				bool v1_v4_connection_flag = isContained<VertexHandle>(getNeighboringVertexHandles(vh1), vh4);
+				bool v1_v4_connection_flag;
+				{
+					VertexSet v1_neighbors(scratch);
+					getNeighboringVertexHandles(vh1, v1_neighbors);
+					v1_v4_connection_flag = v1_neighbors.contains(vh4);
+				}
 				// Step 4.2 Check if there is an edge from v1 to v4.
-				if(!v1_v4_connection_flag) v1_v4_connection_flag = isContained<VertexHandle>(getNeighboringVertexHandles(vh4), vh1);
+				if(!v1_v4_connection_flag)
+				{
+					VertexSet v4_neighbors(scratch);
+					getNeighboringVertexHandles(vh4, v4_neighbors);
+					v1_v4_connection_flag = v4_neighbors.contains(vh1);
+				}
 				if(!v1_v4_connection_flag)
 				{
 					// Step #5: If the vertex V1 and V4 are not connected,
@@ -173,6 +199,7 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle vertex_handle)
 		}
 		if(!updated_flag) ++ehh;
 	}
+	EXPENSIVE_ASSERT(isConsistent());
 	// Do NOT include the current filament into the list of affected
 	// vertices because it must remain valid through the later update
 	// of reaction interactions.
@@ -264,10 +291,11 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle child_vertex_hand
 				VertexHandle closest_vertex_handle = intersecting_facet_edges[i]->dual->next->vertex;
 				removeFacet(intersecting_facet_handle);
 				removeFacet(closest_facet_handle);
-				assert(addFacet(child_vertex_handle, shared_vertex_handle_1, intersecting_vertex_handle));
-				assert(addFacet(child_vertex_handle, intersecting_vertex_handle, shared_vertex_handle_2));
-				assert(addFacet(child_vertex_handle, shared_vertex_handle_2, closest_vertex_handle));
-				assert(addFacet(child_vertex_handle, closest_vertex_handle, shared_vertex_handle_1));
+				[[maybe_unused]] bool facet_addition_flag = addFacet(child_vertex_handle, shared_vertex_handle_1, intersecting_vertex_handle);
+				facet_addition_flag &= addFacet(child_vertex_handle, intersecting_vertex_handle, shared_vertex_handle_2);
+				facet_addition_flag &= addFacet(child_vertex_handle, shared_vertex_handle_2, closest_vertex_handle);
+				facet_addition_flag &= addFacet(child_vertex_handle, closest_vertex_handle, shared_vertex_handle_1);
+				assert(facet_addition_flag);
 				affected_vertices.push_back(intersecting_vertex_handle);
 				affected_vertices.push_back(closest_vertex_handle);
 				affected_vertices.push_back(shared_vertex_handle_1);
@@ -373,16 +401,18 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle child_vertex_hand
 							VertexHandleHandle vhh2 = vhh;
 							if(vhh2 == polygon_vertices.begin()) --vhh2;
 							--vhh2;
+							[[maybe_unused]] bool facet_addition_flag;
 							if(distance_comparison[k])
 							{
-								assert(addFacet(child_vertex_handle, *vhh2, *vhh3));
-								if(distance_comparison[l] != distance_comparison[k]) assert(addFacet(child_vertex_handle, *vhh3, shared_vertex_handle));
+								facet_addition_flag = addFacet(child_vertex_handle, *vhh2, *vhh3);
+								if(distance_comparison[l] != distance_comparison[k]) facet_addition_flag &= addFacet(child_vertex_handle, *vhh3, shared_vertex_handle);
 							}
 							else
 							{
-								assert(addFacet(shared_vertex_handle, *vhh2, *vhh3));
-								if(distance_comparison[l] != distance_comparison[k]) assert(addFacet(shared_vertex_handle, *vhh3, child_vertex_handle));
+								facet_addition_flag = addFacet(shared_vertex_handle, *vhh2, *vhh3);
+								if(distance_comparison[l] != distance_comparison[k]) facet_addition_flag &= addFacet(shared_vertex_handle, *vhh3, child_vertex_handle);
 							}
+							assert(facet_addition_flag);
 							++k;
 						}
 						if(distance_comparison != 0) delete [] distance_comparison;
@@ -426,6 +456,7 @@ VertexHandles SurfaceTopology::updateLocalSurface(VertexHandle child_vertex_hand
 	// may also be included in the list based on the addition of
 	// the child vertex to the local surface of the mother filament.
 	affected_vertices.push_front(child_vertex_handle);
+	EXPENSIVE_ASSERT(isConsistent());
 	return affected_vertices;
 }
 
@@ -440,9 +471,9 @@ double SurfaceTopology::computeIntegralOfSurfaceCurvature(VertexHandles vertex_h
 	double curvature_integral = 0;
 	for(VertexHandleHandle vhh = vertex_handles.begin(); vhh != vertex_handles.end(); ++vhh)
 	{
-		Vector Ri(CartesianCoordinate(0, 0, 0), (*vhh)->getLocation());
+		Vec3d Ri = (*vhh)->getLocation().toVec3();
 		double sigma = 0;
-		Vector covariant_laplacian;
+		Vec3d covariant_laplacian;
 		EdgeHandles& ehs = (*vhh)->edges;
 		for(EdgeHandleHandle ehh = ehs.begin(); ehh != ehs.end(); ++ehh)
 		{
@@ -468,24 +499,20 @@ double SurfaceTopology::computeIntegralOfSurfaceCurvature(VertexHandles vertex_h
 			//                    j
 			//
 			VertexHandle vhj = (*ehh)->prev->vertex;
-			Vector Rj(CartesianCoordinate(0, 0, 0), vhj->getLocation());
-			VertexHandle vhk1 = (*ehh)->next->vertex;
-			VertexHandle vhk2 = (*ehh)->dual->next->vertex;
-			Vector Vk1i(vhk1->getLocation(), (*vhh)->getLocation());
-			Vector Vk1j(vhk1->getLocation(), vhj->getLocation());
-			double theta1 = angle(Vk1i, Vk1j);
-			Vector Vk2i(vhk2->getLocation(), (*vhh)->getLocation());
-			Vector Vk2j(vhk2->getLocation(), vhj->getLocation());
-			double theta2 = angle(Vk2i, Vk2j);
-			Vector Rij = Ri - Rj;
-			double lij = abs(Rij);
+			Vec3d Rj = vhj->getLocation().toVec3();
+			Vec3d Rk1 = (*ehh)->next->vertex->getLocation().toVec3();
+			Vec3d Rk2 = (*ehh)->dual->next->vertex->getLocation().toVec3();
+			double theta1 = angle(Ri - Rk1, Rj - Rk1);
+			double theta2 = angle(Ri - Rk2, Rj - Rk2);
+			Vec3d Rij = Ri - Rj;
+			double lij = norm(Rij);
 			double theta1_cot = cot(theta1); 
 			double theta2_cot = cot(theta2);
 			assert(::finite(theta1_cot) && ::finite(theta2_cot));
 			covariant_laplacian += (Rij * (0.5 * (theta1_cot + theta2_cot)));
 			sigma += (0.5 * (theta1_cot + theta2_cot) * lij * lij);
 		}
-		double covariant_laplacian_abs = abs(covariant_laplacian);
+		double covariant_laplacian_abs = norm(covariant_laplacian);
 		sigma /= 4;
 		curvature_integral += (covariant_laplacian_abs * covariant_laplacian_abs / sigma);
 	}
@@ -498,8 +525,7 @@ bool SurfaceTopology::perturbLocalSurface(VertexHandle vertex_handle)
 	/// The local surface around the given vertex is perturbed by
 	/// adding one actin monomer to corresponding filament.
 	///
-	ParameterTable::Table& param_table = ParameterTable::instance();
-	double actin_diameter = strtod(param_table[std::string("actin_diameter")]);
+	double actin_diameter = strtod(ParameterTable::lookup("actin_diameter"));
 	FilamentBranchHandle branch_handle = vertex_handle->getFilament();
 	bool result = branch_handle->perturbTailEndLocation(Actin("ATP", actin_diameter / 2));
 	return result;
@@ -524,7 +550,7 @@ double SurfaceTopology::computeAreaOfLocalSurface(VertexHandle vertex_handle)
 	return surface_area;
 }
 
-Vector SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(VertexHandle vertex_handle)
+Vec3d SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(VertexHandle vertex_handle)
 {
 	///
 	/// The centered directional area of a neighboring triangular
@@ -553,22 +579,23 @@ Vector SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(VertexHandl
 	///
 	/// This algorithm needs to be double checked!
 	///
-	Vector total_direct_area;
+	Vec3d total_direct_area;
+	Vec3d v = vertex_handle->getLocation().toVec3();
 	EdgeHandles& ehs = vertex_handle->edges;
 	for(EdgeHandleHandle ehh = ehs.begin(); ehh != ehs.end(); ++ehh)
 	{
 		FacetHandle& fh = (*ehh)->facet;
 		Triangle t = fh->getTriangle();
-		Vector direct_area(vertex_handle->getLocation(), t.getCenter());
-		direct_area.setMag(fh->area);
+		Vec3d direct_area = t.getCenter().toVec3() - v;
+		direct_area *= fh->area / norm(direct_area);
 		total_direct_area += direct_area;
 	}
 	return total_direct_area;
 }
 
-Vector SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(CartesianCoordinate v, FacetHandle facet_handle)
+Vec3d SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(CartesianCoordinate v, FacetHandle facet_handle)
 {
-	Vector total_direct_area;
+	Vec3d total_direct_area;
 	Triangle facet_triangle = facet_handle->getTriangle();
 	const CartesianCoordinate* vs = facet_triangle.getVertices();
 	for(size_t i = 0; i < 3; ++i)
@@ -577,8 +604,8 @@ Vector SurfaceTopology::computeCenteredDirectionalAreaOfLocalSurface(CartesianCo
 		if(i < 2) j = i + 1;
 		else j = 0;
 		Triangle t(v, vs[i], vs[j]);
-		Vector direct_area(v, t.getCenter());
-		direct_area.setMag(t.getArea());
+		Vec3d direct_area = t.getCenter().toVec3() - v.toVec3();
+		direct_area *= t.getArea() / norm(direct_area);
 		total_direct_area += direct_area;
 	}
 	return total_direct_area;
@@ -611,70 +638,77 @@ bool SurfaceTopology::triangulatePolygonSurface(VertexHandles polygon_vertices)
 	///
 	/// Algorithm
 	///
-	/// The re-triangulation of a 3D polygon includes two parts: the traverse
-	/// process and the decision-making process.
-	///
-	/// 1) The traverse process is an edge-based process that goes through all
-	/// edges linking the neighboring vertices of the polygon and form smaller
-	/// polygon. This process is outlined in the following steps:
-	///
-	///     a) Start from an edge of the given 3D polygon and traverse in a
-	///     counter-clockwise direction.
-	///
-	///     b) Connect all qualified two neighboring edges of the polygon and
-	///     create non-overlapping new facets.
+	/// The polygon is triangulated by ear clipping. An ear is the candidate
+	/// facet (v0, v1, v2) formed by a polygon vertex v1 and its two neighbors
+	/// along the boundary. Clipping an ear adds this facet into cell surface
+	/// and removes v1 from the polygon.
 	///
-	///     c) Traverse back to the starting edge and the remaining boundary
-	///     edges form a new smaller 3D polygon.
+	/// 1) The polygon vertices are indexed in an array and linked to their
+	/// neighbors by index. The existing edges among polygon vertices are
+	/// recorded in an indexed adjacency table, such that the occupation test
+	/// of a candidate facet does not need to scan any incident edge list.
 	///
-	///     d) Repeat the re-triangulation process until the new 3D polygon
-	///     becomes a triangle and then create a new facet from this triangle.
+	/// 2) All eligible ears are kept in a priority queue. The ear with the
+	/// highest priority is clipped first, and then only the ears at its two
+	/// neighboring vertices are re-evaluated, because the ears elsewhere on
+	/// the polygon are not affected. Outdated queue entries are discarded
+	/// lazily by comparing their stamps with the current stamps of vertices.
 	///
-	/// 2) The decision-make process is to select a qulified facet triangle that
-	/// satisfies the following empirical requirements:
+	/// 3) The clipping is repeated until the remaining polygon becomes a
+	/// triangle and then a new facet is created from this triangle.
 	///
-	///     a) Triangle tends to be as regular as possible:
+	/// The priority of an ear follows these empirical requirements:
 	///
-	///     Choice #1 - compare side length (current implementation).
+	///     a) Occupation eligibility: if the boundary edges (v1 --> v0) and
+	///     (v2 --> v1) belong to the same facet, or if the edge (v2 --> v0)
+	///     already exists, then the ear is invalid. This eligibility is
+	///     required by the topology of 2-manifold surface, which must be
+	///     satisfied.
 	///
-	///     If a(i) (i=1,2,3) denotes the length of the three side of the
-	///     triangle, then always select a triangle with the minimum value of:
+	///     b) Orientation eligibility: if n is the normal vector of the new
+	///     triangular facet, and n1 and n2 are the normal vectors of two
+	///     side-neighboring triangular facets of the new facet, then the
+	///     following requirements should be satisfied:
 	///
-	///                       max{a(i)} - min{a(i)}
-	///                      -----------------------
-	///                             min{a(i)}
-	///
-	///     Choice #2 - use 2D Delaunay triangulation.
+	///                 n * n1 >= 0   and   n * n2 >= 0
 	///
-	///     b) If n is the normal vector of the new triangular facet, and n1
-	///     and n2 are the normal vectors of two side-neighboring triangular
-	///     facets of the new facet, then the following requirements must be
-	///     satisfied:
+	///     This eligibility is required by surface smoothness, which can be
+	///     compromised if no orientationally eligible ear exists.
 	///
-	///                 n * n1 >= 0   and   n * n2 >= 0
+	///     c) Triangle tends to be as regular as possible. Among the ears of
+	///     the same eligibility, the one with the highest regularity of its
+	///     triangle is clipped first (see Triangle::getRegularity()).
 	///
 	///
 	/// Attention
 	///
-	/// Since this function keeps changing the list of boundary vertices
-	/// constantly, it is important to use the value-passing scheme to
-	/// accept the input argument.
+	/// If no ear is occupationally eligible before the polygon becomes a
+	/// triangle, the given polygon is topologically faulty and this function
+	/// returns false.
 	///
 	bool eligibility_flag = true;
+	size_t n_corner = polygon_vertices.size();
+	std::vector<VertexHandle> corners(polygon_vertices.begin(), polygon_vertices.end());
+	// The boundary edge (corners[i + 1] --> corners[i]) of each corner.
+	std::vector<EdgeHandle> boundary_edges(n_corner);
 	// Prerequisite #1
-	if(polygon_vertices.size() < 3) eligibility_flag = false;
+	if(n_corner < 3) eligibility_flag = false;
 	else
 	{
-		for(VertexHandleHandle vhh = polygon_vertices.begin(); vhh != polygon_vertices.end(); ++vhh)
+		for(size_t i = 0; i < n_corner; ++i)
 		{
-			VertexHandleHandle vhh1 = vhh;
-			if(++vhh1 == polygon_vertices.end()) ++vhh1;
+			size_t j = i + 1;
+			if(j == n_corner) j = 0;
 			bool neighboring_edge_flag = false;
-			for(EdgeHandleHandle ehh = (*vhh)->edges.begin(); ehh != (*vhh)->edges.end(); ++ehh)
+			for(EdgeHandleHandle ehh = corners[i]->edges.begin(); ehh != corners[i]->edges.end(); ++ehh)
 			{
 				VertexHandle begin_vertex_handle = (*ehh)->prev->vertex;
 				// Prerequisite #2
-				if(begin_vertex_handle == *vhh1 && (*ehh)->dual == edge_handle_null) neighboring_edge_flag = true;
+				if(begin_vertex_handle == corners[j] && (*ehh)->dual == edge_handle_null)
+				{
+					boundary_edges[i] = *ehh;
+					neighboring_edge_flag = true;
+				}
 			}
 			if(!neighboring_edge_flag)
 			{
@@ -685,276 +719,94 @@ bool SurfaceTopology::triangulatePolygonSurface(VertexHandles polygon_vertices)
 	}
 	if(eligibility_flag)
 	{
-		VertexHandleHandle vhh, vhh0, vhh1, vhh2, vhh3;
-		VertexHandles new_polygon_vertices;
-		bool re_triangulation_flag = false;
-		while(polygon_vertices.size() >= 3)
+		// The adjacency table: adjacency[i * n_corner + j] is true if
+		// the edge (corners[i] --> corners[j]) exists.
+		std::vector<bool> adjacency(n_corner * n_corner, false);
+		for(size_t j = 0; j < n_corner; ++j)
 		{
-			bool traverse_stop_flag = false;
-			vhh = polygon_vertices.begin();
-			while(vhh != polygon_vertices.end())
+			for(EdgeHandleHandle ehh = corners[j]->edges.begin(); ehh != corners[j]->edges.end(); ++ehh)
 			{
-				// This variable indicates the type of candidate triangulation
-				// facet to be selected:
-				//
-				// 0: No triangulation facet is added.
-				// 1: Type-1 triangulation facet is added.
-				// 2: Type-2 triangulation facet is added.
-				size_t facet_addition_type = 0;
-				vhh1 = vhh;
-				vhh0 = vhh1;
-				if(--vhh0 == polygon_vertices.end()) --vhh0;
-				vhh2 = vhh1;
-				if(++vhh2 == polygon_vertices.end()) ++vhh2;
-				vhh3 = vhh2;
-				if(++vhh3 == polygon_vertices.end()) ++vhh3;
-				if(vhh3 != vhh0)
-				{
-					// The current polygon has at least four vertices.
-					//
-					// The following steps are taken to select an eligible triangle:
-					//
-					// 1) Construct two candidate facets from four neighboring vertices
-					// on the boundary of the given 3D polygon:
-					//
-					//      (vhh0, vhh1, vhh2) and (vhh1, vhh2, vhh3).
-					//
-					// 2) Occupation eligibility
-					//
-					// a) If the facets contructed from these sets of vertices already exist,
-					// say, the existing neighboring edges (vhh1 --> vhh0) and (vhh2 --> vhh1)
-					// belong to the same existing facet, then the candidate facet (vhh0,
-					// vhh1, vhh2) is invalid.
-					//
-					// b) If the edge connecting the non-neighboring vertices of the candidate
-					// facet already exists, say the edge (vhh2 --> vhh0), then candidate facet
-					// (vhh0, vhh1, vhh2) is invalid.
-					//
-					// This eligibility is required by the topology of 2-manifold surface,
-					// which must be satisfied.
-					//
-					// 3) Orientation eligibility
-					//
-					// a) If there is only one candidate facet, say, (vhh0, vhh1, vhh2),
-					// check its orientation relationships with its two side-neighboring
-					// facets which have the following boundary edges:
-					//
-					//              edge (v1 --> v0) and edge (v2 --> v1)
-					//
-					// b) If there are two candidate facets, check their orientation
-					// relationships with their three side-neighboring facets which have
-					// the following boundary edges:
-					//
-					//     edge (v1 --> v0), edge (v2 --> v1) and edge (v3 --> v2)
-					//
-					// Each candidate facet is eligible only if its orientation is not
-					// againt to both of its two side-neighboring facets.
-					// edges:
-					//
-					// This eligibility is required by surface smoothness, which can be
-					// compromised under certain circumstances.
-					//
-					// 4) If both candiate facets are orientationally eligible, compare
-					// the regularity of corresponding triangles.
-					//
-					// 5) If neither of candiate facets is orientationally eligible, then
-					// move forward conditionally along the polygon boundary.
-					//
-					//
-					// Step #1
-					// Corresponding candidate triangles are constructed after their
-					// occupation eligibilities are examined.
-					VertexHandle candidate_vertices[4];
-					candidate_vertices[0] = *vhh0;
-					candidate_vertices[1] = *vhh1;
-					candidate_vertices[2] = *vhh2;
-					candidate_vertices[3] = *vhh3;
-					// Step #2
-					EdgeHandle candidate_edges[3];
-					for(size_t i = 0; i < 3; ++i)
-					{
-						for(EdgeHandleHandle ehh = candidate_vertices[i]->edges.begin(); ehh != candidate_vertices[i]->edges.end(); ++ehh)
-						{
-							if((*ehh)->prev->vertex == candidate_vertices[i + 1]) candidate_edges[i] = *ehh;
-						}
-					}
-					bool non_occupation_flags[2] = {true, true};
-					// Step #2 (a)
-					for(size_t i = 0; i < 2; ++i)
-					{
-						if(candidate_edges[i]->facet != candidate_edges[i + 1]->facet) non_occupation_flags[i] = true;
-						else non_occupation_flags[i] = false;
-					}
-					// Step #2 (b)
-					for(size_t i = 0; i < 2; ++i)
-					{
-						for(EdgeHandleHandle ehh = candidate_vertices[i]->edges.begin(); ehh != candidate_vertices[i]->edges.end(); ++ehh)
-						{
-							if((*ehh)->prev->vertex == candidate_vertices[i + 2]) non_occupation_flags[i] = false;
-						}
-					}
-					// Construct candidate triangles.
-					Triangle candidate_triangles[2];
-					for(size_t i = 0; i < 2; ++i)
-					{
-						if(non_occupation_flags[i]) candidate_triangles[i] = Triangle(candidate_vertices[i]->getLocation(), candidate_vertices[i + 1]->getLocation(), candidate_vertices[i + 2]->getLocation());
-					}
-					// Step #3
-					FacetHandle neighboring_facets[3];
-					for(size_t i = 0; i < 3; ++i)
-					{
-						for(EdgeHandleHandle ehh = candidate_vertices[i]->edges.begin(); ehh != candidate_vertices[i]->edges.end(); ++ehh)
-						{
-							if((*ehh)->prev->vertex == candidate_vertices[i + 1]) neighboring_facets[i] = (*ehh)->facet;
-						}
-					}
-					double orientation_consistencies[2][2];
-					for(size_t i = 0; i < 2; ++i)
-					{
-						for(size_t j = 0; j < 2; ++j)
-						{
-							if(non_occupation_flags[i]) orientation_consistencies[i][j] = dotProd(candidate_triangles[i].getNormal(), neighboring_facets[i + j]->getTriangle().getNormal());
-							else orientation_consistencies[i][j] = -1;
-						}
-					}
-					bool consistent_orientation_flags[2] = {true, true};
-					for(size_t i = 0; i < 2; ++i)
-					{
-						for(size_t j = 0; j < 2; ++j)
-						{
-							if(orientation_consistencies[i][j] < 0)
-							{
-								consistent_orientation_flags[i] = false;
-								break;
-							}
-						}
-					}
-					// Step #4
-					//
-					// Only the satisfying candidate facets are subject to the
-					// calculation of triangular regularity. Two criteria are
-					// used to make decision:
-					//
-					// 1) Occupation eligibility has the highest priority and
-					// it must be satisfied.
-					//
-					// 2) If occupation eligibility is satisfied, then check
-					// the orientation eligibility.
-					double regularities[2];
-					for(size_t i = 0; i < 2; ++i)
-					{
-						if(non_occupation_flags[i])
-						{
-							if(!re_triangulation_flag)
-							{
-								// In the normal triangulation of current polygon, the check for
-								// surface smoothness is required.
-								if(consistent_orientation_flags[i]) regularities[i] = candidate_triangles[i].getRegularity();
-								else regularities[i] = 0;
-							}
-							else
-							{
-								// In the re-triangulation of current polygon, the check for
-								// surface smoothness is not required.
-								regularities[i] = candidate_triangles[i].getRegularity();
-							}
-						}
-						else regularities[i] = 0;
-					}
-					double max_regularity = 0;
-					for(size_t i = 0; i < 2; ++i)
-					{
-						if(regularities[i] > max_regularity)
-						{
-							max_regularity = regularities[i];
-							facet_addition_type = i + 1;
-						}
-					}
-					if(facet_addition_type > 0)
-					{
-						// Add the facet of corresponding type into cell surface.
-						assert(addFacet(candidate_vertices[facet_addition_type - 1], candidate_vertices[facet_addition_type], candidate_vertices[facet_addition_type + 1]));
-						if(candidate_vertices[facet_addition_type - 1] != new_polygon_vertices.front() && candidate_vertices[facet_addition_type - 1] != new_polygon_vertices.back()) new_polygon_vertices.push_back(candidate_vertices[facet_addition_type - 1]);
-						if(candidate_vertices[facet_addition_type + 1] != new_polygon_vertices.front() && candidate_vertices[facet_addition_type + 1] != new_polygon_vertices.back()) new_polygon_vertices.push_back(candidate_vertices[facet_addition_type + 1]);
-					}
-					else
-					{
-						// Do not add any candidate facets.
-						if(candidate_vertices[1] != new_polygon_vertices.front() && candidate_vertices[1] != new_polygon_vertices.back()) new_polygon_vertices.push_back(candidate_vertices[1]);
-					}
-					// Step #5
-					for(size_t i = 0; i < facet_addition_type + 1; ++i)
-					{
-						if(++vhh == polygon_vertices.end()) ++vhh;
-						if(new_polygon_vertices.front() == polygon_vertices.back())
-						{
-							// Finish traversing at the last second vertex of current polygon.
-							VertexHandleHandle pv_last_second_vhh = polygon_vertices.end();
-							--pv_last_second_vhh; --pv_last_second_vhh;
-							if(vhh == pv_last_second_vhh)
-							{
-								if(*vhh != candidate_vertices[facet_addition_type] && *vhh != new_polygon_vertices.front() && *vhh != new_polygon_vertices.back()) new_polygon_vertices.push_back(*vhh);
-								traverse_stop_flag = true;
-							}
-						}
-						else if(new_polygon_vertices.front() == polygon_vertices.front())
-						{
-							VertexHandleHandle npv_second_vhh = ++(new_polygon_vertices.begin());
-							VertexHandleHandle pv_second_vhh = ++(polygon_vertices.begin());
-							VertexHandleHandle pv_third_vhh = pv_second_vhh;
-							++pv_third_vhh;
-							if(*npv_second_vhh == *pv_third_vhh)
-							{
-								// Finish traversing at the last vertex of current polygon.
-								VertexHandleHandle pv_last_vhh = --(polygon_vertices.end());
-								if(vhh == pv_last_vhh)
-								{
-									if(*vhh != candidate_vertices[facet_addition_type] && *vhh != new_polygon_vertices.front() && *vhh != new_polygon_vertices.back()) new_polygon_vertices.push_back(*vhh);
-									traverse_stop_flag = true;
-								}
-							}
-							else if(*npv_second_vhh == *pv_second_vhh)
-							{
-								// Finish traversing at the first vertex of current polygon.
-								if(vhh == polygon_vertices.begin()) traverse_stop_flag = true;
-							}
-						}
-					}
-				}
-				else
-				{
-					// The current polygon is a triangle.
-					assert(addFacet(*vhh0, *vhh1, *vhh2));
-					new_polygon_vertices.clear();
-					traverse_stop_flag = true;
-				}
-				if(traverse_stop_flag) break;
+				std::vector<VertexHandle>::iterator cit = std::find(corners.begin(), corners.end(), (*ehh)->prev->vertex);
+				if(cit != corners.end()) adjacency[(cit - corners.begin()) * n_corner + j] = true;
 			}
-			if(new_polygon_vertices.size() < polygon_vertices.size())
+		}
+		// The circular links among the remaining polygon vertices.
+		std::vector<size_t> prev_corners(n_corner), next_corners(n_corner);
+		for(size_t i = 0; i < n_corner; ++i)
+		{
+			prev_corners[i] = (i == 0 ? n_corner - 1 : i - 1);
+			next_corners[i] = (i + 1 == n_corner ? 0 : i + 1);
+		}
+		std::vector<size_t> stamps(n_corner, 0);
+		// An ear is ordered by its orientation eligibility first, then by
+		// its regularity and finally by its corner index for determinism.
+		struct Ear
+		{
+			bool consistent_orientation;
+			double regularity;
+			size_t corner;
+			size_t stamp;
+			bool operator<(const Ear& e) const
 			{
-				// The triangulation of a given polygon into a smaller polygon
-				// is successful.
-				polygon_vertices.clear();
-				polygon_vertices = new_polygon_vertices;
-				re_triangulation_flag = false;
+				if(consistent_orientation != e.consistent_orientation) return !consistent_orientation;
+				if(regularity != e.regularity) return regularity < e.regularity;
+				return corner > e.corner;
 			}
-			else
+		};
+		std::priority_queue<Ear> ears;
+		auto evaluate_ear = [&](size_t i)
+		{
+			++stamps[i];
+			size_t i0 = prev_corners[i];
+			size_t i2 = next_corners[i];
+			// Occupation eligibility
+			if(boundary_edges[i0]->facet == boundary_edges[i]->facet) return;
+			if(adjacency[i2 * n_corner + i0]) return;
+			// Orientation eligibility
+			Triangle candidate_triangle(corners[i0]->getLocation(), corners[i]->getLocation(), corners[i2]->getLocation());
+			bool consistent_orientation = true;
+			if(dotProd(candidate_triangle.getNormal(), boundary_edges[i0]->facet->getTriangle().getNormal()) < 0) consistent_orientation = false;
+			else if(dotProd(candidate_triangle.getNormal(), boundary_edges[i]->facet->getTriangle().getNormal()) < 0) consistent_orientation = false;
+			ears.push(Ear{consistent_orientation, candidate_triangle.getRegularity(), i, stamps[i]});
+		};
+		for(size_t i = 0; i < n_corner; ++i) evaluate_ear(i);
+		size_t n_remaining_corner = n_corner;
+		size_t last_corner = 0;
+		while(n_remaining_corner > 3)
+		{
+			// Discard the outdated ears.
+			while(!ears.empty() && ears.top().stamp != stamps[ears.top().corner]) ears.pop();
+			if(ears.empty())
 			{
-				// The triangulation of a given polygon into a smaller polygon
-				// is not successful. Therefore loosen the orientation eligibility
-				// and triangulate current polygon again. 
-				//
-				// Attention
-				//
-				// Re-triangulation can only occurs once because if the polygon
-				// after the first re-triangulation is the same as the given one,
-				// it means that loosening the orientation eligibility does not
-				// help triangulating this polygon. In other words, the given
-				// polygon is topologically faulty.
-				assert(re_triangulation_flag == false);
-				re_triangulation_flag = true;
+				// The given polygon is topologically faulty.
+				eligibility_flag = false;
+				break;
 			}
-			new_polygon_vertices.clear();
+			size_t i = ears.top().corner;
+			ears.pop();
+			size_t i0 = prev_corners[i];
+			size_t i2 = next_corners[i];
+			[[maybe_unused]] bool facet_addition_flag = addFacet(corners[i0], corners[i], corners[i2]);
+			assert(facet_addition_flag);
+			// The new boundary edge (corners[i2] --> corners[i0]) is the
+			// first edge of the new facet.
+			boundary_edges[i0] = getLastFacetHandle()->edges[0];
+			adjacency[i0 * n_corner + i] = true;
+			adjacency[i * n_corner + i2] = true;
+			adjacency[i2 * n_corner + i0] = true;
+			next_corners[i0] = i2;
+			prev_corners[i2] = i0;
+			++stamps[i];
+			--n_remaining_corner;
+			evaluate_ear(i0);
+			evaluate_ear(i2);
+			last_corner = i2;
+		}
+		if(eligibility_flag)
+		{
+			// The remaining polygon is a triangle.
+			[[maybe_unused]] bool facet_addition_flag = addFacet(corners[prev_corners[last_corner]], corners[last_corner], corners[next_corners[last_corner]]);
+			assert(facet_addition_flag);
 		}
 	}
 	return eligibility_flag;
@@ -972,7 +824,8 @@ void SurfaceTopology::insertVerex(VertexHandle vertex_handle, FacetHandle facet_
 	{
 		size_t j = i + 1;
 		if(j > 2) j = 0;
-		assert(addFacet(vertex_handle, selected_facet_vertices[i], selected_facet_vertices[j]));
+		[[maybe_unused]] bool facet_addition_flag = addFacet(vertex_handle, selected_facet_vertices[i], selected_facet_vertices[j]);
+		assert(facet_addition_flag);
 	}
 }
 
@@ -984,6 +837,29 @@ void SurfaceTopology::updateNeighboringFacets(VertexHandle vertex_handle)
 		area -= (*fhh)->area;
 		(*fhh)->update();
 		area += (*fhh)->area;
+		facet_grid.update(*fhh);
+	}
+}
+
+void SurfaceTopology::refitFacetGrid()
+{
+	///
+	/// The cell size of the facet grid follows the mean edge length.
+	/// Since the mean edge length changes slowly during cell spreading,
+	/// it is estimated from the mean facet area as if all facets were
+	/// equilateral, and the grid is only rebuilt when this estimate
+	/// differs from the cell size by a factor of two.
+	///
+	if(facets.empty()) return;
+	double mean_facet_area = area / facets.size();
+	double estimated_edge_length = std::sqrt(4 * mean_facet_area / std::sqrt(3.0));
+	double cell_size = facet_grid.getCellSize();
+	if(!facet_grid.isBuilt() || estimated_edge_length > 2 * cell_size || estimated_edge_length < cell_size / 2)
+	{
+		double total_edge_length = 0;
+		for(EdgeHandle eh = edges.begin(); eh != edges.end(); ++eh) total_edge_length += distance(eh->prev->vertex->getLocation(), eh->vertex->getLocation());
+		double mean_edge_length = total_edge_length / edges.size();
+		if(mean_edge_length > 0) facet_grid.rebuild(facets, mean_edge_length);
 	}
 }
 
@@ -1171,7 +1047,7 @@ bool SurfaceTopology::addFacet(VertexHandle vh1, VertexHandle vh2, VertexHandle
 			if(!vertex_edges.empty())
 			{
 				bool share_edge_flag = false;
-				bool share_vertex_flag = false;
+				[[maybe_unused]] bool share_vertex_flag = false;
 				for(EdgeHandleHandle ehh = vertex_edges.begin(); ehh != vertex_edges.end(); ++ehh)
 				{
 					// Case 1
@@ -1217,10 +1093,97 @@ bool SurfaceTopology::addFacet(VertexHandle vh1, VertexHandle vh2, VertexHandle
 		}
 		// End of integration.
 		area += fh->area;
+		facet_grid.insert(fh);
 	}
 	return eligibility;
 }
 
+void SurfaceTopology::addFacets(const std::vector<VertexHandle>& vertex_table, const std::vector<size_t>& facet_table)
+{
+	///
+	/// The facets are integrated into the surface in the same way as
+	/// addFacet does, so that the edge list of each vertex is sorted
+	/// in the same clockwise order. Since an edge can only be shared
+	/// by two facets, the dual of a new edge is the unique existing
+	/// edge in the opposite direction, which is looked up by the
+	/// indices of its beginning and incident vertices.
+	///
+	assert(facet_table.size() % 3 == 0);
+	const std::uint64_t vertex_num = vertex_table.size();
+	std::unordered_map<std::uint64_t, EdgeHandle> edge_table;
+	edge_table.reserve(facet_table.size());
+	for(size_t k = 0; k < facet_table.size(); k += 3)
+	{
+		edges.push_back(Edge(vertex_table[facet_table[k]]));
+		edges.push_back(Edge(vertex_table[facet_table[k + 1]]));
+		edges.push_back(Edge(vertex_table[facet_table[k + 2]]));
+		EdgeHandle eh = edges.end();
+		EdgeHandle eh3 = (--eh);
+		EdgeHandle eh2 = (--eh);
+		EdgeHandle eh1 = (--eh);
+		eh1->prev = eh3; eh1->next = eh2;
+		eh2->prev = eh1; eh2->next = eh3;
+		eh3->prev = eh2; eh3->next = eh1;
+		Facet f(eh1, eh2, eh3);
+		facets.push_back(f);
+		FacetHandle fh = (--facets.end());
+		eh1->facet = fh;
+		eh2->facet = fh;
+		eh3->facet = fh;
+		EdgeHandle ehs[3];
+		ehs[0] = eh1;
+		ehs[1] = eh2;
+		ehs[2] = eh3;
+		for(size_t i = 0; i < 3; ++i)
+		{
+			// The edge ehs[i] points from the vertex of its previous
+			// edge to its own vertex.
+			std::uint64_t begin_index = facet_table[k + (i + 2) % 3];
+			std::uint64_t end_index = facet_table[k + i];
+			assert(edge_table.find(begin_index * vertex_num + end_index) == edge_table.end());
+			edge_table[begin_index * vertex_num + end_index] = ehs[i];
+			EdgeHandles& vertex_edges = ehs[i]->vertex->edges;
+			if(!vertex_edges.empty())
+			{
+				std::unordered_map<std::uint64_t, EdgeHandle>::iterator dual_it = edge_table.find(end_index * vertex_num + begin_index);
+				if(dual_it != edge_table.end())
+				{
+					// Case 1
+					//
+					// The dual edge is the next edge of an incident edge
+					// of the vertex, after which the current edge is inserted.
+					EdgeHandle dual_eh = dual_it->second;
+					assert(dual_eh->dual == edge_handle_null);
+					dual_eh->dual = ehs[i];
+					(ehs[i])->dual = dual_eh;
+					EdgeHandleHandle ehh = std::find(vertex_edges.begin(), vertex_edges.end(), dual_eh->prev);
+					assert(ehh != vertex_edges.end());
+					vertex_edges.insert(++ehh, ehs[i]);
+				}
+				else
+				{
+					// Case 2
+					[[maybe_unused]] bool share_vertex_flag = false;
+					for(EdgeHandleHandle ehh = vertex_edges.begin(); ehh != vertex_edges.end(); ++ehh)
+					{
+						if((*ehh)->prev->vertex == ehs[i]->next->vertex)
+						{
+							vertex_edges.insert(ehh, ehs[i]);
+							share_vertex_flag = true;
+							break;
+						}
+					}
+					assert(share_vertex_flag);
+				}
+			}
+			// Case 3
+			else vertex_edges.push_back(ehs[i]);
+		}
+		area += fh->area;
+		facet_grid.insert(fh);
+	}
+}
+
 void SurfaceTopology::removeFacet(FacetHandle fh)
 {
 	///
@@ -1262,6 +1225,7 @@ void SurfaceTopology::removeFacet(FacetHandle fh)
 	for(size_t i = 0; i < 3; ++i) edges.erase(facet_edges[i]);
 	// Update membrane area
 	area -= fh->area;
+	facet_grid.remove(fh);
 	// Finally remove this facet.
 	facets.erase(fh);
 }
@@ -1317,10 +1281,54 @@ VertexHandles SurfaceTopology::removeVertex(VertexHandle vh)
 	vertices.erase(vh);
 	// The polygonal hole left by the removal of current vertex
 	// must be triangulated.
-	assert(triangulatePolygonSurface(polygon_vertices));
+	[[maybe_unused]] bool triangulation_flag = triangulatePolygonSurface(polygon_vertices);
+	assert(triangulation_flag);
+	EXPENSIVE_ASSERT(isConsistent());
 	return polygon_vertices;
 }
 
+bool SurfaceTopology::isConsistent()
+{
+	// Each edge closes a triangle with its previous and next edges of
+	// the same facet, and is the dual of its dual edge, which points
+	// from the end to the beginning of this edge.
+	for(EdgeHandle eh = edges.begin(); eh != edges.end(); ++eh)
+	{
+		if(eh->next->prev != eh || eh->prev->next != eh || eh->next->next != eh->prev) return false;
+		if(eh->next->facet != eh->facet || eh->prev->facet != eh->facet) return false;
+		if(eh->dual != edge_handle_null)
+		{
+			if(eh->dual->dual != eh || eh->dual->vertex != eh->prev->vertex) return false;
+		}
+	}
+	// Each facet links to the three edges which link back to it, and
+	// the membrane area is the sum of facet areas up to rounding.
+	double facet_area_sum = 0;
+	for(FacetHandle fh = facets.begin(); fh != facets.end(); ++fh)
+	{
+		for(size_t i = 0; i < 3; ++i)
+		{
+			if(fh->edges[i]->facet != fh) return false;
+		}
+		facet_area_sum += fh->area;
+	}
+	if(edges.size() != 3 * facets.size()) return false;
+	if(std::fabs(facet_area_sum - area) > 1e-9 * std::fmax(facet_area_sum, 1)) return false;
+	// Each vertex is linked to its filament in both directions, and the
+	// edges in its list point to it.
+	size_t n_uncapped = 0;
+	for(VertexHandle vh = vertices.begin(); vh != vertices.end(); ++vh)
+	{
+		if(vh->filament->getVertex() != vh) return false;
+		if(!vh->filament->isCapped()) ++n_uncapped;
+		for(EdgeHandleHandle ehh = vh->edges.begin(); ehh != vh->edges.end(); ++ehh)
+		{
+			if((*ehh)->vertex != vh) return false;
+		}
+	}
+	return (n_uncapped == n_uncapped_vertex);
+}
+
 void SurfaceTopology::updateCompositeProperties(VertexHandle vh, bool pos_change, bool cap_change)
 {
 	///
@@ -1337,7 +1345,7 @@ void SurfaceTopology::updateCompositeProperties(VertexHandle vh, bool pos_change
 	}
 }
 
-VertexHandles SurfaceTopology::getNeighboringVertexHandles(VertexHandle vertex_handle) const
+VertexHandles SurfaceTopology::getNeighboringVertexHandles(VertexHandle vertex_handle, std::pmr::memory_resource* resource) const
 {
 	///
 	/// The closest neighboring vertices of the given vertex are
@@ -1347,9 +1355,9 @@ VertexHandles SurfaceTopology::getNeighboringVertexHandles(VertexHandle vertex_h
 	/// This algorithm also works if holes exist around the local
 	/// surface of the given vertex.
 	///
-	VertexHandles neighboring_vertices;
-	EdgeHandles vertex_edges = vertex_handle->edges;
-	for(EdgeHandles::reverse_iterator ehh = vertex_edges.rbegin(); ehh != vertex_edges.rend(); ++ehh)
+	VertexHandles neighboring_vertices(resource);
+	const EdgeHandles& vertex_edges = vertex_handle->edges;
+	for(EdgeHandles::const_reverse_iterator ehh = vertex_edges.rbegin(); ehh != vertex_edges.rend(); ++ehh)
 	{
 		EdgeHandle curr_edge = (*ehh);
 		EdgeHandle next_edge = curr_edge->next;
@@ -1360,6 +1368,18 @@ VertexHandles SurfaceTopology::getNeighboringVertexHandles(VertexHandle vertex_h
 	return neighboring_vertices;
 }
 
+void SurfaceTopology::getNeighboringVertexHandles(VertexHandle vertex_handle, VertexSet& neighboring_vertices) const
+{
+	const EdgeHandles& vertex_edges = vertex_handle->edges;
+	for(EdgeHandles::const_reverse_iterator ehh = vertex_edges.rbegin(); ehh != vertex_edges.rend(); ++ehh)
+	{
+		EdgeHandle curr_edge = (*ehh);
+		EdgeHandle next_edge = curr_edge->next;
+		if(next_edge->dual == edge_handle_null) neighboring_vertices.insert(next_edge->vertex);
+		neighboring_vertices.insert(curr_edge->prev->vertex);
+	}
+}
+
 FacetHandles SurfaceTopology::getNeighboringFacetHandles(VertexHandle vertex_handle) const
 {
 	///
@@ -1452,13 +1472,13 @@ FacetHandles SurfaceTopology::getLocalFacetHandles(VertexHandle vertex_handle) c
 	return local_facets;
 }
 
-Orientation SurfaceTopology::computeBranchingOrientation(const CartesianCoordinate& bs, double alpha, const CartesianCoordinate& tip, Triangle& t)
+Orientation SurfaceTopology::computeBranchingOrientation(const CartesianCoordinate& bs, double alpha, const CartesianCoordinate& tip, const Triangle& t)
 {
 	Orientation orient;
 	Line line_b_tip(bs, tip);
-	Vector vector_b_tip = line_b_tip.getVector();
-	double dist_b_tip = vector_b_tip.getMag();
-	Vector n = t.getNormal();
+	const Vec3d& vector_b_tip = line_b_tip.getVector();
+	double dist_b_tip = norm(vector_b_tip);
+	const Vec3d& n = t.getNormal();
 	if(!isEqual(dotProd(vector_b_tip, n), 0))
 	{
 		//
@@ -1491,11 +1511,11 @@ Orientation SurfaceTopology::computeBranchingOrientation(const CartesianCoordina
 		double dist_b_v0 = distance(bs, v0);
 		CartesianCoordinate p = projection(bs, t);
 		double dist_b_p = distance(p, bs);
-		double angle_v0_b_p = 0.5 * M_PI - std::asin(dist_b_p / dist_b_v0);
+		double angle_v0_b_p = 0.5 * M_PI - simulation::math::asin(dist_b_p / dist_b_v0);
 		// angle_p_b_d may be less than zero.
 		double angle_p_b_d = alpha - angle_v0_b_p;
 		// dist_p_d may be less than zero.
-		double dist_p_d = dist_b_p * std::tan(angle_p_b_d);
+		double dist_p_d = dist_b_p * simulation::math::tan(angle_p_b_d);
 		double dist_v0_p = distance(p, tip);
 		double dist_v0_d = dist_v0_p + dist_p_d;
 		Line line_v0_p(tip, p);
@@ -1534,16 +1554,15 @@ Orientation SurfaceTopology::computeBranchingOrientation(const CartesianCoordina
 			//                   D
 			// outside cell
 			//
-			double dist_tip_d = dist_b_tip * std::tan(alpha);
-			Line line_tip_d(tip, n);
-			CartesianCoordinate d = line_tip_d.getLocation(dist_tip_d, false);
+			double dist_tip_d = dist_b_tip * simulation::math::tan(alpha);
+			CartesianCoordinate d = tip.toVec3() + n * dist_tip_d;
 			orient = Vector(bs, d).getOrient();
 		}
 		else
 		{
 			// If the branching angle of the child filament is equal to
 			// 90 degree
-			orient = n.getOrient();
+			orient = Vector(n).getOrient();
 		}
 	}
 	assert(finite(orient.theta) && finite(orient.phi));
@@ -1560,11 +1579,10 @@ bool SurfaceTopology::isBranchingAllowed(FilamentBranch& branch)
 	bool branching_flag = false;
 	FacetHandle selected_branching_facet = facet_handle_null;
 	Orientation selected_branching_orient;
-	if(branch.getBranchingSiteActinConstHandle() != actin_handle_null)
+	if(branch.hasBranchingSiteActin())
 	{
-		ParameterTable::Table& param_table = ParameterTable::instance();
-		double cortical_region_thickness = strtod(param_table[std::string("cortical_region_thickness")]);
-		double branching_angle = strtod(param_table[std::string("branching_angle")]) * M_PI / 180;
+		double cortical_region_thickness = strtod(ParameterTable::lookup("cortical_region_thickness"));
+		double branching_angle = strtod(ParameterTable::lookup("branching_angle")) * M_PI / 180;
 		CartesianCoordinate branching_site_location = branch.getBranchingSiteActinLocation();
 		CartesianCoordinate filament_tip_location = branch.getTailEndLocation();
 		FacetHandles cortical_facets;
@@ -1596,21 +1614,24 @@ bool SurfaceTopology::isBranchingAllowed(FilamentBranch& branch)
 				intersect_orients.push_back(child_branch_orient);
 			}
 		}
-		double deviation_angle_min = DBL_INF_POSITIVE;
+		// The smallest deviation angle has the largest cosine, and it is
+		// less than the maximum deviation angle if its cosine is greater
+		// than the cosine of the maximum.
+		double deviation_cosine_max = -DBL_INF_POSITIVE;
 		OrientationHandle oh = intersect_orients.begin();
 		for(fhh = intersect_facets.begin(); fhh != intersect_facets.end(); ++fhh)
 		{
-			double deviation_angle = computeDeviationAngleOfFilamentGrowth(branch, *oh);
-			if(deviation_angle < deviation_angle_min)
+			double deviation_cosine = computeDeviationCosineOfFilamentGrowth(branch, *oh);
+			if(deviation_cosine > deviation_cosine_max)
 			{
 				selected_branching_facet = *fhh;
 				selected_branching_orient = *oh;
-				deviation_angle_min = deviation_angle;
+				deviation_cosine_max = deviation_cosine;
 			}
 			++oh;
 		}
-		double max_deviation_angle = strtod(param_table[std::string("max_deviation_angle")]) * M_PI / 180;
-		if(deviation_angle_min < max_deviation_angle)
+		double max_deviation_angle = strtod(ParameterTable::lookup("max_deviation_angle")) * M_PI / 180;
+		if(deviation_cosine_max > std::cos(max_deviation_angle))
 		{
 			branch.setChildBranchOrient(selected_branching_orient);
 			branch.setChildBranchFacet(selected_branching_facet);
@@ -1643,6 +1664,34 @@ FacetHandle SurfaceTopology::getIntersectingFacetHandle(FilamentBranch& branch,
 			}
 		}
 	}
+	if(intersecting_facet_handle == facet_handle_null)
+	{
+		// The local search fails, then search the whole membrane surface
+		// if it is allowed.
+		if(global_facet_search_flag) intersecting_facet_handle = getIntersectingFacetHandle(l);
+	}
+	return intersecting_facet_handle;
+}
+
+FacetHandle SurfaceTopology::getIntersectingFacetHandle(Line& l)
+{
+	FacetHandle intersecting_facet_handle = facet_handle_null;
+	refitFacetGrid();
+	FacetHandles candidates = facet_grid.getCandidateFacetHandles(l);
+	double closest_distance = DBL_INF_POSITIVE;
+	for(FacetHandleHandle fhh = candidates.begin(); fhh != candidates.end(); ++fhh)
+	{
+		Triangle t = (*fhh)->getTriangle();
+		if(isIntersecting(l, t))
+		{
+			double dist = distance(intersection(l, t), l.getEnd());
+			if(dist < closest_distance)
+			{
+				intersecting_facet_handle = *fhh;
+				closest_distance = dist;
+			}
+		}
+	}
 	return intersecting_facet_handle;
 }
 
@@ -1656,27 +1705,32 @@ Orientation SurfaceTopology::computeExtraCellularOrientation(const CartesianCoor
 
 double SurfaceTopology::computeDeviationAngleOfFilamentGrowth(FilamentBranch& branch)
 {
-	Vector prefered_growth_vector(1, computeExtraCellularOrientation(branch.getHeadEndLocation()));
-	Vector filament_vector(1, branch.getOrient());
+	return computeDeviationAngleOfFilamentGrowth(FilamentStateTable::instance()[branch.getId()]);
+}
+
+double SurfaceTopology::computeDeviationAngleOfFilamentGrowth(const FilamentState& state)
+{
+	Vector prefered_growth_vector(1, computeExtraCellularOrientation(GeometryPrecision::loadCoordinate(state.head_end_location)));
+	Vector filament_vector(state.direction.x, state.direction.y, state.direction.z);
 	double deviation_angle = angle(filament_vector, prefered_growth_vector);
 	return deviation_angle;
 }
 
 
-double SurfaceTopology::computeDeviationAngleOfFilamentGrowth(FilamentBranch& mother_branch, const Orientation& child_branch_orient)
+double SurfaceTopology::computeDeviationCosineOfFilamentGrowth(FilamentBranch& mother_branch, const Orientation& child_branch_orient)
 {
 	Vector child_branch_orient_vector(1, child_branch_orient);
 	CartesianCoordinate branching_site_location = mother_branch.getBranchingSiteActinLocation();
 	Vector prefered_growth_vector(1, computeExtraCellularOrientation(branching_site_location));
-	double deviation_angle = angle(child_branch_orient_vector, prefered_growth_vector);
-	return deviation_angle;
+	double deviation_cosine = dotProd(child_branch_orient_vector, prefered_growth_vector) / (abs(child_branch_orient_vector) * abs(prefered_growth_vector));
+	return deviation_cosine;
 }
 
 bool SurfaceTopology::searchFusionFacetForChildBranch(Line& child_branch_line, VertexHandle mother_branch_vertex, FacetHandle& child_fusion_facet)
 {
 	bool found_flag = false;
 	CartesianCoordinate child_branch_end = child_branch_line.getEnd();
-	Vector child_branch_vector = child_branch_line.getVector();
+	const Vec3d& child_branch_vector = child_branch_line.getVector();
 	// Step 1. Find the facets with the same direction as the given line
 	// and such facet must exist.
 	FacetHandles same_dir_facets;
@@ -1718,24 +1772,27 @@ bool SurfaceTopology::searchFusionFacetForChildBranch(Line& child_branch_line, V
 	return found_flag;
 }
 
-void SurfaceTopology::exportGeometry(std::ofstream& output, char delim)
+void SurfaceTopology::exportGeometry(TrajectoryFrame& frame)
 {
-	output << "OFF" << std::endl;
-	output << vertices.size() << delim << facets.size() << " 0" << std::endl;
-	VertexHandle vh;
-	for(vh = vertices.begin(); vh != vertices.end(); ++vh)
+	frame.vertex_ids.clear();
+	frame.locations.clear();
+	frame.capped.clear();
+	frame.lengths.clear();
+	frame.facets.clear();
+	std::unordered_map<const Vertex*, size_t> vertex_positions;
+	vertex_positions.reserve(vertices.size());
+	for(VertexHandle vh = vertices.begin(); vh != vertices.end(); ++vh)
 	{
-		CartesianCoordinate p = vh->filament->getTailEndLocation();
-		output << p.x << delim << p.y << delim << p.z << std::endl;
+		FilamentId fid = vh->filament->getHandle();
+		frame.vertex_ids.push_back((static_cast<uint64_t>(fid.generation) << 32) | fid.index);
+		frame.locations.push_back(vh->filament->getTailEndLocation().toVec3());
+		frame.capped.push_back(vh->filament->isCapped());
+		frame.lengths.push_back(static_cast<uint32_t>(vh->filament->length()));
+		vertex_positions.insert(std::make_pair(&(*vh), vertex_positions.size()));
 	}
-	FacetHandle fh;
-	for(fh = facets.begin(); fh != facets.end(); ++fh)
+	for(FacetHandle fh = facets.begin(); fh != facets.end(); ++fh)
 	{
-		output << '3';
-		for(size_t i = 0; i < 3; ++i) output << delim << getVertexHandlePosition(fh->edges[i]->vertex);
-		// Set facet color to purple.
-		output << delim << "0.666" << delim << "0.666" << delim << "0.888";
-		output << std::endl;
+		for(size_t i = 0; i < 3; ++i) frame.facets.push_back(static_cast<uint32_t>(vertex_positions[&(*(fh->edges[i]->vertex))]));
 	}
 }
 
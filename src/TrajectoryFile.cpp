@@ -0,0 +1,419 @@
+#include <cmath>
+#include <cstring>
+#include <TrajectoryFile.hpp>
+
+namespace motility
+{
+
+namespace
+{
+
+const char file_magic[8] = {'C', 'E', 'L', 'L', 'T', 'R', 'J', '1'};
+
+const char end_magic[8] = {'C', 'E', 'L', 'L', 'T', 'R', 'J', 'E'};
+
+const uint32_t key_frame_tag = 0x4659454b; // "KEYF"
+
+const uint32_t delta_frame_tag = 0x46544c44; // "DLTF"
+
+const uint32_t index_tag = 0x58444e49; // "INDX"
+
+// The size of the header, i.e. the magic and the quantum.
+const uint64_t header_size = 16;
+
+// The size of the tag and the payload size of a chunk.
+const uint64_t chunk_head_size = 12;
+
+// The size of the trailer, i.e. the footer offset and the magic.
+const uint64_t trailer_size = 16;
+
+// The vertex locations are quantized on a grid of 2^-20 um.
+const double location_quantum = 1.0 / 1048576;
+
+const size_t key_frame_interval = 32;
+
+void putU32(std::vector<uint8_t>& buf, uint32_t v)
+{
+	for(size_t i = 0; i < 4; ++i) buf.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putU64(std::vector<uint8_t>& buf, uint64_t v)
+{
+	for(size_t i = 0; i < 8; ++i) buf.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putBytes(std::vector<uint8_t>& buf, const char* bytes, size_t n)
+{
+	for(size_t i = 0; i < n; ++i) buf.push_back(static_cast<uint8_t>(bytes[i]));
+}
+
+void putF64(std::vector<uint8_t>& buf, double v)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &v, sizeof(bits));
+	putU64(buf, bits);
+}
+
+// The signed integers are zigzag-encoded such that small magnitudes of
+// either sign take few bytes, and then written in groups of 7 bits.
+void putVarint(std::vector<uint8_t>& buf, int64_t v)
+{
+	uint64_t u = (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+	while(u >= 0x80)
+	{
+		buf.push_back(static_cast<uint8_t>(u | 0x80));
+		u >>= 7;
+	}
+	buf.push_back(static_cast<uint8_t>(u));
+}
+
+/// ByteCursor struct reads the numbers from a buffer, and remembers
+/// whether a read has run past its end.
+struct ByteCursor
+{
+	const uint8_t* p;
+
+	const uint8_t* end;
+
+	bool good;
+
+	ByteCursor(const std::vector<uint8_t>& buf) : p(buf.data()), end(buf.data() + buf.size()), good(true) {}
+
+	uint64_t getBytes(size_t n)
+	{
+		if(static_cast<size_t>(end - p) < n)
+		{
+			good = false;
+			p = end;
+			return 0;
+		}
+		uint64_t v = 0;
+		for(size_t i = 0; i < n; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+		p += n;
+		return v;
+	}
+
+	uint32_t getU32() { return static_cast<uint32_t>(getBytes(4)); }
+
+	uint64_t getU64() { return getBytes(8); }
+
+	double getF64()
+	{
+		uint64_t bits = getU64();
+		double v;
+		std::memcpy(&v, &bits, sizeof(v));
+		return v;
+	}
+
+	int64_t getVarint()
+	{
+		uint64_t u = 0;
+		for(size_t shift = 0; shift < 64; shift += 7)
+		{
+			if(p == end)
+			{
+				good = false;
+				return 0;
+			}
+			uint8_t b = *p++;
+			u |= static_cast<uint64_t>(b & 0x7f) << shift;
+			if(!(b & 0x80)) return static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+		}
+		good = false;
+		return 0;
+	}
+};
+
+bool readBytes(std::ifstream& stream, uint64_t offset, size_t n, std::vector<uint8_t>& buf)
+{
+	buf.resize(n);
+	stream.clear();
+	stream.seekg(static_cast<std::streamoff>(offset));
+	stream.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(n));
+	return (static_cast<size_t>(stream.gcount()) == n);
+}
+
+}
+
+// TrajectoryFrame definitions
+
+size_t TrajectoryFrame::getVertexSize() const
+{
+	return locations.size();
+}
+
+size_t TrajectoryFrame::getFacetSize() const
+{
+	return facets.size() / 3;
+}
+
+void TrajectoryFrame::exportGeometry(std::ostream& output, char delim) const
+{
+	output << "OFF" << std::endl;
+	output << getVertexSize() << delim << getFacetSize() << " 0" << std::endl;
+	for(size_t i = 0; i < locations.size(); ++i) output << locations[i].x << delim << locations[i].y << delim << locations[i].z << std::endl;
+	for(size_t f = 0; f < getFacetSize(); ++f)
+	{
+		output << '3';
+		for(size_t i = 0; i < 3; ++i) output << delim << facets[3 * f + i];
+		// Set facet color to purple.
+		output << delim << "0.666" << delim << "0.666" << delim << "0.888";
+		output << std::endl;
+	}
+}
+
+// TrajectoryWriter definitions
+
+TrajectoryWriter::TrajectoryWriter(const std::string& fn)
+{
+	name = fn;
+	frames_since_key_frame = 0;
+	stream.open(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(stream.is_open())
+	{
+		chunk.clear();
+		putBytes(chunk, file_magic, 8);
+		putF64(chunk, location_quantum);
+		stream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+	}
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+	close();
+}
+
+std::string TrajectoryWriter::getName() const
+{
+	return name;
+}
+
+bool TrajectoryWriter::isOpen() const
+{
+	return stream.is_open();
+}
+
+size_t TrajectoryWriter::getFrameSize() const
+{
+	return frame_times.size();
+}
+
+void TrajectoryWriter::write(const TrajectoryFrame& frame)
+{
+	if(!stream.is_open()) return;
+	size_t n = frame.getVertexSize();
+	std::vector<int64_t> quantized(3 * n);
+	for(size_t i = 0; i < n; ++i)
+	{
+		quantized[3 * i] = std::llround(frame.locations[i].x / location_quantum);
+		quantized[3 * i + 1] = std::llround(frame.locations[i].y / location_quantum);
+		quantized[3 * i + 2] = std::llround(frame.locations[i].z / location_quantum);
+	}
+	// The topology is only written when it changes, or when the key
+	// frame interval is reached.
+	bool key_frame = (frame_times.empty() || frames_since_key_frame + 1 >= key_frame_interval || frame.vertex_ids != last_vertex_ids || frame.facets != last_facets);
+	chunk.clear();
+	putF64(chunk, frame.time);
+	putU32(chunk, static_cast<uint32_t>(n));
+	if(key_frame)
+	{
+		putU32(chunk, static_cast<uint32_t>(frame.getFacetSize()));
+		// The ids and the facet indices are mostly ascending, so they are
+		// encoded as the differences from their predecessors.
+		for(size_t i = 0; i < n; ++i) putVarint(chunk, static_cast<int64_t>(frame.vertex_ids[i] - (i > 0 ? frame.vertex_ids[i - 1] : 0)));
+		for(size_t i = 0; i < frame.facets.size(); ++i) putVarint(chunk, static_cast<int64_t>(frame.facets[i]) - (i > 0 ? frame.facets[i - 1] : 0));
+		for(size_t i = 0; i < quantized.size(); ++i) putVarint(chunk, quantized[i]);
+	}
+	else
+	{
+		for(size_t i = 0; i < quantized.size(); ++i) putVarint(chunk, quantized[i] - last_locations[i]);
+	}
+	for(size_t i = 0; i < n; i += 8)
+	{
+		uint8_t bits = 0;
+		for(size_t j = i; j < n && j < i + 8; ++j)
+		{
+			if(frame.capped[j]) bits |= static_cast<uint8_t>(1 << (j - i));
+		}
+		chunk.push_back(bits);
+	}
+	for(size_t i = 0; i < n; ++i) putVarint(chunk, frame.lengths[i]);
+	uint64_t offset = static_cast<uint64_t>(stream.tellp());
+	std::vector<uint8_t> head;
+	putU32(head, (key_frame ? key_frame_tag : delta_frame_tag));
+	putU64(head, chunk.size());
+	stream.write(reinterpret_cast<const char*>(head.data()), static_cast<std::streamsize>(head.size()));
+	stream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+	if(key_frame)
+	{
+		last_vertex_ids = frame.vertex_ids;
+		last_facets = frame.facets;
+		frames_since_key_frame = 0;
+	}
+	else ++frames_since_key_frame;
+	last_locations.swap(quantized);
+	frame_times.push_back(frame.time);
+	frame_offsets.push_back(offset);
+	key_frame_offsets.push_back(key_frame ? offset : key_frame_offsets.back());
+}
+
+void TrajectoryWriter::close()
+{
+	if(!stream.is_open()) return;
+	uint64_t footer_offset = static_cast<uint64_t>(stream.tellp());
+	chunk.clear();
+	putU32(chunk, index_tag);
+	putU64(chunk, 8 + 24 * frame_times.size());
+	putU64(chunk, frame_times.size());
+	for(size_t k = 0; k < frame_times.size(); ++k)
+	{
+		putF64(chunk, frame_times[k]);
+		putU64(chunk, frame_offsets[k]);
+		putU64(chunk, key_frame_offsets[k]);
+	}
+	putU64(chunk, footer_offset);
+	putBytes(chunk, end_magic, 8);
+	stream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+	stream.close();
+}
+
+// TrajectoryReader definitions
+
+TrajectoryReader::TrajectoryReader()
+{
+	quantum = 0;
+}
+
+bool TrajectoryReader::open(const std::string& fn)
+{
+	stream.open(fn.c_str(), std::ios::in | std::ios::binary);
+	if(!stream.is_open()) return false;
+	std::vector<uint8_t> buf;
+	if(!readBytes(stream, 0, header_size, buf) || std::memcmp(buf.data(), file_magic, 8) != 0) return false;
+	ByteCursor cursor(buf);
+	cursor.getBytes(8);
+	quantum = cursor.getF64();
+	frame_times.clear();
+	frame_offsets.clear();
+	key_frame_offsets.clear();
+	return (readIndex() || scanChunks());
+}
+
+bool TrajectoryReader::readIndex()
+{
+	stream.clear();
+	stream.seekg(0, std::ios::end);
+	uint64_t file_size = static_cast<uint64_t>(stream.tellg());
+	if(file_size < header_size + trailer_size) return false;
+	std::vector<uint8_t> buf;
+	if(!readBytes(stream, file_size - trailer_size, trailer_size, buf) || std::memcmp(buf.data() + 8, end_magic, 8) != 0) return false;
+	uint64_t footer_offset = ByteCursor(buf).getU64();
+	if(footer_offset < header_size || footer_offset + chunk_head_size + trailer_size > file_size) return false;
+	if(!readBytes(stream, footer_offset, file_size - trailer_size - footer_offset, buf)) return false;
+	ByteCursor cursor(buf);
+	if(cursor.getU32() != index_tag) return false;
+	cursor.getU64();
+	uint64_t count = cursor.getU64();
+	for(uint64_t k = 0; k < count && cursor.good; ++k)
+	{
+		frame_times.push_back(cursor.getF64());
+		frame_offsets.push_back(cursor.getU64());
+		key_frame_offsets.push_back(cursor.getU64());
+	}
+	if(!cursor.good)
+	{
+		frame_times.clear();
+		frame_offsets.clear();
+		key_frame_offsets.clear();
+	}
+	return cursor.good;
+}
+
+bool TrajectoryReader::scanChunks()
+{
+	// The chunks are visited by their sizes until the index footer, or
+	// until a chunk is truncated.
+	uint64_t offset = header_size;
+	std::vector<uint8_t> buf;
+	while(readBytes(stream, offset, chunk_head_size + 8, buf))
+	{
+		ByteCursor cursor(buf);
+		uint32_t tag = cursor.getU32();
+		uint64_t size = cursor.getU64();
+		if(tag != key_frame_tag && tag != delta_frame_tag) break;
+		if(tag == delta_frame_tag && key_frame_offsets.empty()) break;
+		std::vector<uint8_t> payload;
+		if(!readBytes(stream, offset + chunk_head_size, size, payload)) break;
+		frame_times.push_back(cursor.getF64());
+		frame_offsets.push_back(offset);
+		key_frame_offsets.push_back(tag == key_frame_tag ? offset : key_frame_offsets.back());
+		offset += chunk_head_size + size;
+	}
+	return true;
+}
+
+bool TrajectoryReader::readChunk(uint64_t offset, TrajectoryFrame& frame, std::vector<int64_t>& locations)
+{
+	std::vector<uint8_t> buf;
+	if(!readBytes(stream, offset, chunk_head_size, buf)) return false;
+	ByteCursor head(buf);
+	uint32_t tag = head.getU32();
+	uint64_t size = head.getU64();
+	if(!readBytes(stream, offset + chunk_head_size, size, buf)) return false;
+	ByteCursor cursor(buf);
+	frame.time = cursor.getF64();
+	size_t n = cursor.getU32();
+	if(tag == key_frame_tag)
+	{
+		size_t n_facet = cursor.getU32();
+		frame.vertex_ids.resize(n);
+		for(size_t i = 0; i < n; ++i) frame.vertex_ids[i] = (i > 0 ? frame.vertex_ids[i - 1] : 0) + static_cast<uint64_t>(cursor.getVarint());
+		frame.facets.resize(3 * n_facet);
+		for(size_t i = 0; i < frame.facets.size(); ++i) frame.facets[i] = static_cast<uint32_t>((i > 0 ? frame.facets[i - 1] : 0) + cursor.getVarint());
+		locations.resize(3 * n);
+		for(size_t i = 0; i < locations.size(); ++i) locations[i] = cursor.getVarint();
+	}
+	else if(tag == delta_frame_tag)
+	{
+		if(locations.size() != 3 * n) return false;
+		for(size_t i = 0; i < locations.size(); ++i) locations[i] += cursor.getVarint();
+	}
+	else return false;
+	frame.locations.resize(n);
+	for(size_t i = 0; i < n; ++i) frame.locations[i] = Vec3d(locations[3 * i] * quantum, locations[3 * i + 1] * quantum, locations[3 * i + 2] * quantum);
+	frame.capped.resize(n);
+	for(size_t i = 0; i < n; i += 8)
+	{
+		uint8_t bits = static_cast<uint8_t>(cursor.getBytes(1));
+		for(size_t j = i; j < n && j < i + 8; ++j) frame.capped[j] = ((bits >> (j - i)) & 1);
+	}
+	frame.lengths.resize(n);
+	for(size_t i = 0; i < n; ++i) frame.lengths[i] = static_cast<uint32_t>(cursor.getVarint());
+	return cursor.good;
+}
+
+size_t TrajectoryReader::getFrameSize() const
+{
+	return frame_times.size();
+}
+
+double TrajectoryReader::getFrameTime(size_t k) const
+{
+	return frame_times[k];
+}
+
+bool TrajectoryReader::read(size_t k, TrajectoryFrame& frame)
+{
+	if(k >= frame_times.size()) return false;
+	// The frames are decoded from the key frame up to the k-th frame.
+	size_t first = k;
+	while(frame_offsets[first] != key_frame_offsets[k]) --first;
+	std::vector<int64_t> locations;
+	for(size_t j = first; j <= k; ++j)
+	{
+		if(!readChunk(frame_offsets[j], frame, locations)) return false;
+	}
+	return true;
+}
+
+}
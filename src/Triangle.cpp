@@ -28,9 +28,11 @@ Triangle::Triangle(const CartesianCoordinate* vs)
 void Triangle::initialize()
 {
 	center = (vertices[0] + vertices[1] + vertices[2]) / 3;
-	normal = crossProd(Vector(vertices[0], vertices[1]), Vector(vertices[0], vertices[2]));
-	area = abs(normal) / 2;
-	normalize(normal);
+	Vec3d v0 = vertices[0].toVec3();
+	normal = crossProd(vertices[1].toVec3() - v0, vertices[2].toVec3() - v0);
+	double length = norm(normal);
+	area = length / 2;
+	normal *= 1 / length;
 }
 
 const CartesianCoordinate* Triangle::getVertices() const
@@ -43,14 +45,8 @@ const CartesianCoordinate& Triangle::getCenter() const
 	return center;
 }
 
-Vector& Triangle::getNormal()
+const Vec3d& Triangle::getNormal() const
 {
-	// The caller of this function may call the member function
-	// of Vector, such as getMag(), getOrient() and normalize(),
-	// and the caller may call the friend functions of Vector,
-	// such as abs() and normalize(). All these functions may
-	// modify the member data of the vector. Therefore this
-	// function is not marked as 'const'.
 	return normal;
 }
 
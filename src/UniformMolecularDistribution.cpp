@@ -3,7 +3,7 @@
 namespace motility
 {
 
-UniformMolecularDistribution::UniformMolecularDistribution(const SpatialBoundary& bound, double dens) : MolecularDistribution(bound)
+UniformMolecularDistribution::UniformMolecularDistribution(const SpatialBoundary& bound, double dens) : MolecularDistribution(bound, UNIFORM)
 {
 	density = dens;
 }
@@ -36,6 +36,21 @@ Vector::Vector(const CartesianCoordinate& bp, const CartesianCoordinate& ep)
 	orient_flag = false;
 }
 
+Vector::Vector(const Vec3d& v)
+{
+	x = v.x; y = v.y; z = v.z;
+	mag = 0;
+	orient.theta = 0;
+	orient.phi = M_PI / 2;
+	mag_flag = false;
+	orient_flag = false;
+}
+
+Vec3d Vector::toVec3() const
+{
+	return Vec3d(x, y, z);
+}
+
 void Vector::clearMag()
 {
 	mag = 0;
@@ -176,27 +191,27 @@ const Vector& Vector::operator+() const
 	return *this;
 }
 
-const Vector Vector::operator-() const
+Vector Vector::operator-() const
 {
 	return Vector(-x, -y, -z);
 }
 
-const Vector Vector::operator+(const Vector& v) const
+Vector Vector::operator+(const Vector& v) const
 {
 	return Vector(x + v.x, y + v.y, z + v.z);
 }
 
-const Vector Vector::operator-(const Vector& v) const
+Vector Vector::operator-(const Vector& v) const
 {
 	return Vector(x - v.x, y - v.y, z - v.z);
 }
 
-const Vector Vector::operator*(double r) const
+Vector Vector::operator*(double r) const
 {
 	return Vector(x * r, y * r, z * r);
 }
 
-const Vector Vector::operator/(double r) const
+Vector Vector::operator/(double r) const
 {
 	return Vector(x / r, y / r, z / r);
 }
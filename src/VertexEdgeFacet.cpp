@@ -9,7 +9,10 @@ namespace motility
 
 // Vertex definitions
 
-Vertex::Vertex() {}
+Vertex::Vertex()
+{
+	mark = 0;
+}
 
 Vertex::Vertex(FilamentBranchHandle branch)
 {
@@ -28,6 +31,7 @@ Vertex::Vertex(FilamentBranchHandle branch)
 	// and added to cell surface.
 	//
 	filament = branch;
+	mark = 0;
 }
 
 FilamentBranchHandle Vertex::getFilament()
@@ -50,6 +54,16 @@ CartesianCoordinate Vertex::getLocation() const
 	return filament->getTailEndLocation();
 }
 
+size_t Vertex::getMark() const
+{
+	return mark;
+}
+
+void Vertex::setMark(size_t m)
+{
+	mark = m;
+}
+
 bool Vertex::operator==(const Vertex& v) const
 {
 	return (filament == v.filament);
@@ -117,10 +131,16 @@ bool Edge::operator!=(const Edge& e) const
 
 // Facet definitions
 
-Facet::Facet() {}
+Facet::Facet()
+{
+	grid_flag = false;
+	grid_stamp = 0;
+}
 
 Facet::Facet(const EdgeHandle& e1, const EdgeHandle& e2, const EdgeHandle& e3)
 {
+	grid_flag = false;
+	grid_stamp = 0;
 	edges[0] = e1;
 	edges[1] = e2;
 	edges[2] = e3;
@@ -141,7 +161,6 @@ void Facet::update()
 {
 	Triangle t(edges[0]->vertex->getLocation(), edges[1]->vertex->getLocation(), edges[2]->vertex->getLocation());
 	area = t.getArea();
-	normal = t.getNormal();
 }
 
 Triangle Facet::getTriangle()
@@ -1,4 +1,5 @@
 #include <algorithms.hpp>
+#include <predicates.hpp>
 #include <ParameterTable.hpp>
 
 namespace motility
@@ -125,31 +126,26 @@ bool selectFromHistogram(const double* hist_dist, size_t size, size_t& index)
 	return select_flag;
 }
 
-double distance(const CartesianCoordinate& point, Triangle& triangle)
+double distance(const CartesianCoordinate& point, const Triangle& triangle)
 {
-	return dotProd(triangle.getNormal(), Vector((triangle.getVertices())[0], point));
+	return dotProd(triangle.getNormal(), point.toVec3() - triangle.getVertices()[0].toVec3());
 }
 
-bool isInPlane(const CartesianCoordinate& point, Triangle& triangle)
+bool isInPlane(const CartesianCoordinate& point, const Triangle& triangle)
 {
 	return isEqual(distance(point, triangle), 0);
 }
 
-CartesianCoordinate projection(const CartesianCoordinate& point, Triangle& triangle)
+CartesianCoordinate projection(const CartesianCoordinate& point, const Triangle& triangle)
 {
 	CartesianCoordinate p;
 	double dist = distance(point, triangle);
 	if(isEqual(dist, 0)) p = point;
-	else
-	{
-		Vector v = triangle.getNormal() * (-dist);
-		Line l(point, v);
-		p = l.getEnd();
-	}
+	else p = point.toVec3() + triangle.getNormal() * (-dist);
 	return p;
 }
 
-CartesianCoordinate barycentric(const CartesianCoordinate& point, Triangle& triangle)
+CartesianCoordinate barycentric(const CartesianCoordinate& point, const Triangle& triangle)
 {
 	const CartesianCoordinate* vertices = triangle.getVertices();
 	Triangle t0(point, vertices[1], vertices[2]);
@@ -162,70 +158,89 @@ CartesianCoordinate barycentric(const CartesianCoordinate& point, Triangle& tria
 	return CartesianCoordinate(x, y, z);
 }
 
-bool isInsideTriangle(const CartesianCoordinate& point, Triangle& triangle)
+bool isInsideTriangle(const CartesianCoordinate& point, const Triangle& triangle)
 {
 	//
-	// This function uses the Barycentric coordinates to determine if
-	// a point in the plane of a given triangle is located within the
-	// triangle. Given the Barycentric coordinates of a point
-	// P (x, y, z), if P is located in the interior of the triangle,
-	// then the summation of x, y and z is 1, otherwise it is greater
-	// than 1.
+	// A point in the plane of a given triangle is located within the
+	// triangle (including its boundary) if it does not lie on the outer
+	// side of any edge of the triangle. The sides are decided by exact
+	// predicates. A degenerate triangle contains no point.
 	//
-	CartesianCoordinate p = barycentric(point, triangle);
-	return isEqual(p.x + p.y + p.z, 1);
+	return isProjectionInsideTriangle(point, triangle);
 }
 
-bool isProjectionInsideTriangle(const CartesianCoordinate& point, Triangle& triangle)
+bool isProjectionInsideTriangle(const CartesianCoordinate& point, const Triangle& triangle)
 {
-	return isInsideTriangle(projection(point, triangle), triangle);
+	//
+	// The projection of a point lies inside a given triangle if it lies
+	// on the inner side of all three edges, which is tested without
+	// computing the projection itself. If the triangle is degenerate,
+	// all three signs are zero.
+	//
+	const CartesianCoordinate* vertices = triangle.getVertices();
+	int signs[3];
+	for(size_t i = 0; i < 3; ++i) signs[i] = orientInPlane(vertices[i], vertices[(i + 1) % 3], vertices[(i + 2) % 3], point);
+	if(signs[0] == 0 && signs[1] == 0 && signs[2] == 0) return false;
+	return (signs[0] >= 0 && signs[1] >= 0 && signs[2] >= 0);
 }
 
-bool isIntersecting(Line& line, Triangle& triangle)
+bool isIntersecting(const Line& line, const Triangle& triangle)
 {
-	bool intersecting;
-	Vector n = triangle.getNormal();
-	Vector l = line.getVector();
+	//
+	// A line segment PQ intersects a triangle ABC if:
+	//
+	// 1) P and Q do not lie strictly on the same side of the plane of
+	// ABC, and PQ does not lie in this plane.
+	//
+	// 2) The line through P and Q passes the edges AB, BC and CA on
+	// the same side, i.e. the three orientations of the tetrahedra
+	// PQAB, PQBC and PQCA do not have opposite signs.
+	//
 	const CartesianCoordinate* vertices = triangle.getVertices();
-	Vector v = Vector(line.getBegin(), vertices[0]);
-	double r = dotProd(n, v) / dotProd(n, l);
-	if(isEqual(r, 0)) r = 0;
-	if(isEqual(r, 1)) r = 1;
-	if(r < 0 || r > 1) intersecting = false;
-	else intersecting = isInsideTriangle(line.getLocation(r), triangle);
-	return intersecting;
+	const CartesianCoordinate& p = line.getBegin();
+	const CartesianCoordinate& q = line.getEnd();
+	int sp = orient3d(vertices[0], vertices[1], vertices[2], p);
+	int sq = orient3d(vertices[0], vertices[1], vertices[2], q);
+	if(sp * sq > 0 || (sp == 0 && sq == 0)) return false;
+	bool positive_flag = false;
+	bool negative_flag = false;
+	for(size_t i = 0; i < 3; ++i)
+	{
+		int s = orient3d(p, q, vertices[i], vertices[(i + 1) % 3]);
+		if(s > 0) positive_flag = true;
+		else if(s < 0) negative_flag = true;
+	}
+	return !(positive_flag && negative_flag);
 }
 
-CartesianCoordinate intersection(Line& line, Triangle& triangle)
+CartesianCoordinate intersection(const Line& line, const Triangle& triangle)
 {
-	Vector n = triangle.getNormal();
-	Vector l = line.getVector();
+	const Vec3d& n = triangle.getNormal();
 	const CartesianCoordinate* vertices = triangle.getVertices();
-	Vector v = Vector(line.getBegin(), vertices[0]);
-	double r = dotProd(n, v) / dotProd(n, l);
+	Vec3d v = vertices[0].toVec3() - line.getBegin().toVec3();
+	double r = dotProd(n, v) / dotProd(n, line.getVector());
 	if(isEqual(r, 0)) r = 0;
 	if(isEqual(r, 1)) r = 1;
 	return line.getLocation(r);
 }
 
-bool isInsideTriangularBox(const CartesianCoordinate& point, Triangle& triangle, double height)
+bool isInsideTriangularBox(const CartesianCoordinate& point, const Triangle& triangle, double height)
 {
 	// The triangular box is defined as a box with a given
 	// triangular facet and a given height in the direction
 	// of the normal vector of the facet.
 	bool inside;
-	CartesianCoordinate p = projection(point, triangle);
-	if(isProjectionInsideTriangle(p, triangle))
+	if(isProjectionInsideTriangle(point, triangle))
 	{
-		double dist = distance(point, triangle);
-		if(isEqual(dist, 0)) inside = true;
+		const CartesianCoordinate* vertices = triangle.getVertices();
+		int side = orient3d(vertices[0], vertices[1], vertices[2], point);
+		if(side == 0) inside = true;
 		else
 		{
 			if(isEqual(height, 0)) inside = false;
 			else
 			{
-				double sides = dist * height;
-				if(sides < 0)
+				if((side > 0) != (height > 0))
 				{
 					// The location of the given point and the box region are
 					// at the opposite sides of the given triangle.
@@ -233,7 +248,7 @@ bool isInsideTriangularBox(const CartesianCoordinate& point, Triangle& triangle,
 				}
 				else
 				{
-					if(std::fabs(dist) <= std::fabs(height)) inside = true;
+					if(std::fabs(distance(point, triangle)) <= std::fabs(height)) inside = true;
 					else inside = false;
 				}
 			}
@@ -251,7 +266,15 @@ double angle(Vector& v1, Vector& v2)
 	return alpha;
 }
 
-double angle(Triangle& t1, Triangle& t2)
+double angle(const Vec3d& v1, const Vec3d& v2)
+{
+	double alpha = std::acos(dotProd(v1, v2) / (norm(v1) * norm(v2)));
+	if(isEqual(alpha, 0)) alpha = 0;
+	else if(isEqual(alpha, M_PI)) alpha = M_PI;
+	return alpha;
+}
+
+double angle(const Triangle& t1, const Triangle& t2)
 {
 	// This function calculates the angle between two triangles
 	// sharing the same edge.
@@ -277,7 +300,10 @@ double angle(Triangle& t1, Triangle& t2)
 	double dist = distance(vertices2[i], t1);
 	assert(std::fabs(dist) > DBL_EPSILON);
 	// These two triangular facets cannot be parallel to each other.
-	double alpha = angle(t1.getNormal(), t2.getNormal());
+	// Their normal vectors are of unit length.
+	double alpha = std::acos(dotProd(t1.getNormal(), t2.getNormal()));
+	if(isEqual(alpha, 0)) alpha = 0;
+	else if(isEqual(alpha, M_PI)) alpha = M_PI;
 	double beta;
 	if(dist > 0) beta = M_PI - alpha;
 	else beta = M_PI + alpha;
@@ -31,11 +31,14 @@ void initializeReactionTypeTable(std::ifstream& input)
 	ReactionTypeTable::Table& reactionTable = ReactionTypeTable::instance();
 	ReactionTypeTable::ReactionType rt;
 	size_t line_cnt = 0;
-	std::string name, rc;
+	std::string name, rc, compartment;
 	while (!input.eof())
 	{
 		std::string buf;
 		getline(input, buf);
+		// A section header names the compartment of the following
+		// reaction types.
+		if(buf.size() > 0 && buf[0] == '[') getWord(buf, compartment, "[]", 0);
 		if(buf.size() > 0 && buf[0] != '[' && buf[0] != ';')
 		{
 			switch(line_cnt)
@@ -77,6 +80,7 @@ void initializeReactionTypeTable(std::ifstream& input)
 			}
 			if(line_cnt > 4)
 			{
+				rt.compartment = compartment;
 				reactionTable[name] = rt;
 				name.clear();
 				rt.clear();
@@ -9,14 +9,19 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <optional>
 #include <constants.hpp>
 #include <algorithms.hpp>
 #include <InputFile.hpp>
 #include <ParameterTable.hpp>
 #include <ReactionTypeTable.hpp>
 #include <MotileCell.hpp>
+#include <MemoryArena.hpp>
 #include <SpatialBoundary.hpp>
 #include <UniformMolecularDistribution.hpp>
+#include <SubstratePatternDistribution.hpp>
+#include <NonUniformMolecularDistribution.hpp>
+#include <LinearGradientMolecularDistributionFunction.hpp>
 #include <initializeParameterTable.hpp>
 #include <initializeReactionTypeTable.hpp>
 #include <CellStatisticsCalculator.hpp>
@@ -36,6 +41,9 @@ void usage_help(char* program_name)
 
 int main(int argc, char* argv[])
 {
+	// All model containers are allocated from the memory pool of the
+	// simulation, which must be installed before any of them exists.
+	MemoryArena::instance().install();
 	// Obtain the home directory of cell motility simulation from
 	// environment settings.
 	char* home_dir_char = std::getenv("MOTILITY_HOME");
@@ -70,26 +78,54 @@ int main(int argc, char* argv[])
 	std::string data_dir;
 	if(!home_dir.empty()) data_dir = home_dir + "/output/";
 	else data_dir = "./";
-	std::string nameBuf = param_table[std::string("cell_geom_filename")];
+	std::string nameBuf = ParameterTable::lookup("cell_geom_filename");
 	std::string cell_geom_filename, cell_geom_filename_ext;
 	bool splitting_flag = splitFileName(nameBuf, cell_geom_filename, cell_geom_filename_ext);
 	if(!splitting_flag) handleErrorEvent("the geometry file does not have an extension name");
 	// Initialize spatially distributed extracellular signaling molecules.
-	double x_min = strtod(param_table[std::string("x_min")]);
-	double x_max = strtod(param_table[std::string("x_max")]);
-	double y_min = strtod(param_table[std::string("y_min")]);
-	double y_max = strtod(param_table[std::string("y_max")]);
-	double z_min = strtod(param_table[std::string("z_min")]);
-	double leading_edge_thickness = strtod(param_table[std::string("leading_edge_thickness")]);
+	double x_min = strtod(ParameterTable::lookup("x_min"));
+	double x_max = strtod(ParameterTable::lookup("x_max"));
+	double y_min = strtod(ParameterTable::lookup("y_min"));
+	double y_max = strtod(ParameterTable::lookup("y_max"));
+	double z_min = strtod(ParameterTable::lookup("z_min"));
+	double leading_edge_thickness = strtod(ParameterTable::lookup("leading_edge_thickness"));
 	SpatialBoundary fibronectin_boundary(x_min, x_max, y_min, y_max, z_min, z_min + leading_edge_thickness);
-	double fibronectin_conc = strtod(param_table[std::string("fibronectin_conc")]);
-	UniformMolecularDistribution fibronectin_dist(fibronectin_boundary, fibronectin_conc);
-	double simulation_time = strtod(param_table[std::string("simulation_time")]);
-	size_t simulation_step = strtoul(param_table[std::string("simulation_step")]);
-	double record_time_interval = strtod(param_table[std::string("record_time_interval")]);
-	size_t record_step_interval = strtoul(param_table[std::string("record_step_interval")]);
+	double fibronectin_conc = strtod(ParameterTable::lookup("fibronectin_conc"));
+	// Fibronectin is either uniform, printed on the glass slide by a
+	// pattern, or coated by a gradient.
+	UniformMolecularDistribution uniform_fibronectin_dist(fibronectin_boundary, fibronectin_conc);
+	std::optional<SubstratePatternDistribution> patterned_fibronectin_dist;
+	// The pattern file is optional.
+	std::string fibronectin_pattern_file;
+	ParameterTable::Table::const_iterator param_ptr = param_table.find("fibronectin_pattern_file");
+	if(param_ptr != param_table.end()) fibronectin_pattern_file = param_ptr->second;
+	if(!fibronectin_pattern_file.empty())
+	{
+		size_t fibronectin_pattern_width = strtoul(ParameterTable::lookup("fibronectin_pattern_width"));
+		size_t fibronectin_pattern_height = strtoul(ParameterTable::lookup("fibronectin_pattern_height"));
+		patterned_fibronectin_dist.emplace(fibronectin_boundary, fibronectin_pattern_file, fibronectin_conc, fibronectin_pattern_width, fibronectin_pattern_height);
+	}
+	// Otherwise fibronectin may be coated by a gradient along the x axis,
+	// which is sampled on a grid.
+	std::optional<NonUniformMolecularDistribution> gradient_fibronectin_dist;
+	double fibronectin_gradient = 0;
+	param_ptr = param_table.find("fibronectin_gradient");
+	if(param_ptr != param_table.end()) fibronectin_gradient = strtod(param_ptr->second);
+	if(!patterned_fibronectin_dist.has_value() && fibronectin_gradient != 0)
+	{
+		double fibronectin_grid_spacing = strtod(ParameterTable::lookup("fibronectin_grid_spacing"));
+		LinearGradientMolecularDistributionFunction fibronectin_func(fibronectin_conc, (x_min + x_max) / 2, fibronectin_gradient);
+		gradient_fibronectin_dist.emplace(fibronectin_boundary, fibronectin_func, fibronectin_grid_spacing);
+	}
+	MolecularDistribution* fibronectin_dist = &uniform_fibronectin_dist;
+	if(patterned_fibronectin_dist.has_value()) fibronectin_dist = &*patterned_fibronectin_dist;
+	else if(gradient_fibronectin_dist.has_value()) fibronectin_dist = &*gradient_fibronectin_dist;
+	double simulation_time = strtod(ParameterTable::lookup("simulation_time"));
+	size_t simulation_step = strtoul(ParameterTable::lookup("simulation_step"));
+	double record_time_interval = strtod(ParameterTable::lookup("record_time_interval"));
+	size_t record_step_interval = strtoul(ParameterTable::lookup("record_step_interval"));
 	// Initialize motile cell.
-	MotileCell motile_cell(simulation_time, simulation_step, record_time_interval, record_step_interval, &fibronectin_dist, data_dir, cell_geom_filename, cell_geom_filename_ext);
+	MotileCell motile_cell(simulation_time, simulation_step, record_time_interval, record_step_interval, fibronectin_dist, data_dir, cell_geom_filename, cell_geom_filename_ext);
 	// Start simulating actin-based cell motility.
 	motile_cell.run();
 	return motile_cell.get_status();
@@ -0,0 +1,208 @@
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <predicates.hpp>
+
+namespace motility
+{
+
+namespace
+{
+
+// The unit roundoff of double precision arithmetic.
+const double unit_roundoff = DBL_EPSILON / 2;
+
+// The relative inflation applied to every error bound, which covers the
+// roundoff of the error bound computation itself.
+const double error_inflation = 1 + 8 * unit_roundoff;
+
+//
+// FilteredValue carries a floating-point value together with an upper bound
+// of its absolute deviation from the exact value of the same expression.
+//
+class FilteredValue
+{
+  public:
+
+	double value;
+
+	double error;
+
+	FilteredValue(double v = 0, double e = 0) : value(v), error(e) {}
+
+	FilteredValue operator+(const FilteredValue& f) const
+	{
+		double v = value + f.value;
+		return FilteredValue(v, (error + f.error + 2 * unit_roundoff * std::fabs(v) + DBL_TRUE_MIN) * error_inflation);
+	}
+
+	FilteredValue operator-(const FilteredValue& f) const
+	{
+		double v = value - f.value;
+		return FilteredValue(v, (error + f.error + 2 * unit_roundoff * std::fabs(v) + DBL_TRUE_MIN) * error_inflation);
+	}
+
+	FilteredValue operator*(const FilteredValue& f) const
+	{
+		double v = value * f.value;
+		double e = std::fabs(value) * f.error + std::fabs(f.value) * error + error * f.error;
+		return FilteredValue(v, (e + 2 * unit_roundoff * std::fabs(v) + DBL_TRUE_MIN) * error_inflation);
+	}
+
+	// The sign is certified only if the value cannot change its sign
+	// within the error bound. Otherwise 2 is returned.
+	int sign() const
+	{
+		if(value > error) return 1;
+		if(value < -error) return -1;
+		return 2;
+	}
+};
+
+//
+// ExactValue represents a real number exactly as a nonoverlapping expansion,
+// i.e. a sum of doubles sorted by increasing magnitude whose nonzero
+// components do not overlap in their significant bits.
+//
+class ExactValue
+{
+	std::vector<double> components;
+
+	static void twoSum(double a, double b, double& x, double& y)
+	{
+		x = a + b;
+		double b_virtual = x - a;
+		double a_virtual = x - b_virtual;
+		y = (a - a_virtual) + (b - b_virtual);
+	}
+
+	static void twoProduct(double a, double b, double& x, double& y)
+	{
+		x = a * b;
+		y = std::fma(a, b, -x);
+	}
+
+	// This function adds a double into the expansion with zero elimination.
+	void grow(double b)
+	{
+		std::vector<double> result;
+		result.reserve(components.size() + 1);
+		double q = b;
+		for(size_t i = 0; i < components.size(); ++i)
+		{
+			double h;
+			twoSum(q, components[i], q, h);
+			if(h != 0) result.push_back(h);
+		}
+		if(q != 0) result.push_back(q);
+		components.swap(result);
+	}
+
+  public:
+
+	ExactValue(double v = 0)
+	{
+		if(v != 0) components.push_back(v);
+	}
+
+	ExactValue operator+(const ExactValue& e) const
+	{
+		ExactValue result(*this);
+		for(size_t i = 0; i < e.components.size(); ++i) result.grow(e.components[i]);
+		return result;
+	}
+
+	ExactValue operator-(const ExactValue& e) const
+	{
+		ExactValue result(*this);
+		for(size_t i = 0; i < e.components.size(); ++i) result.grow(-e.components[i]);
+		return result;
+	}
+
+	ExactValue operator*(const ExactValue& e) const
+	{
+		ExactValue result;
+		for(size_t i = 0; i < components.size(); ++i)
+		{
+			for(size_t j = 0; j < e.components.size(); ++j)
+			{
+				double x, y;
+				twoProduct(components[i], e.components[j], x, y);
+				result.grow(y);
+				result.grow(x);
+			}
+		}
+		return result;
+	}
+
+	// The sign of a nonoverlapping expansion is the sign of its largest
+	// component.
+	int sign() const
+	{
+		if(components.empty()) return 0;
+		return (components.back() > 0 ? 1 : -1);
+	}
+};
+
+template<typename T>
+void difference(const CartesianCoordinate& p, const CartesianCoordinate& q, T* d)
+{
+	d[0] = T(p.x) - T(q.x);
+	d[1] = T(p.y) - T(q.y);
+	d[2] = T(p.z) - T(q.z);
+}
+
+template<typename T>
+void cross(const T* u, const T* v, T* w)
+{
+	w[0] = u[1] * v[2] - u[2] * v[1];
+	w[1] = u[2] * v[0] - u[0] * v[2];
+	w[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+template<typename T>
+T dot(const T* u, const T* v)
+{
+	return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+}
+
+template<typename T>
+T orient3dDeterminant(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& d)
+{
+	T ab[3], ac[3], ad[3], n[3];
+	difference(b, a, ab);
+	difference(c, a, ac);
+	difference(d, a, ad);
+	cross(ab, ac, n);
+	return dot(n, ad);
+}
+
+template<typename T>
+T orientInPlaneProduct(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& p)
+{
+	T ab[3], ac[3], ap[3], n[3], m[3];
+	difference(b, a, ab);
+	difference(c, a, ac);
+	difference(p, a, ap);
+	cross(ab, ac, n);
+	cross(ab, ap, m);
+	return dot(n, m);
+}
+
+}
+
+int orient3d(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& d)
+{
+	int s = orient3dDeterminant<FilteredValue>(a, b, c, d).sign();
+	if(s == 2) s = orient3dDeterminant<ExactValue>(a, b, c, d).sign();
+	return s;
+}
+
+int orientInPlane(const CartesianCoordinate& a, const CartesianCoordinate& b, const CartesianCoordinate& c, const CartesianCoordinate& p)
+{
+	int s = orientInPlaneProduct<FilteredValue>(a, b, c, p).sign();
+	if(s == 2) s = orientInPlaneProduct<ExactValue>(a, b, c, p).sign();
+	return s;
+}
+
+}
@@ -0,0 +1,118 @@
+//
+// This program compares the spreading statistics of two simulations, e.g.
+// of the builds storing the geometry in double and in single precision with
+// the same parameters and random seed. The rounding of the stored geometry
+// may make the stochastic trajectories diverge, so the runs are not compared
+// event by event, but by the time series of the cell statistics file.
+//
+// For each column of the second file, the values are linearly interpolated
+// at the times of the first file, and the mean and the maximum of relative
+// differences are reported. The comparison passes if the mean relative
+// difference of every column is within the tolerance.
+//
+// Usage: CellStatisticsComparison <cell-stats-A.csv> <cell-stats-B.csv> [tolerance]
+//
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const double default_tolerance = 0.05;
+
+// The relative differences are measured against this floor, so that the
+// columns starting at zero, e.g. the spreading velocity, are not blown up.
+const double relative_difference_floor = 1e-6;
+
+struct CellStatistics
+{
+	std::vector<std::string> names;
+
+	// The columns of the file, where the first one is the time.
+	std::vector<std::vector<double>> columns;
+};
+
+bool readCellStatistics(const std::string& file_name, CellStatistics& stats)
+{
+	std::ifstream ifs(file_name);
+	if(!ifs.is_open())
+	{
+		std::cerr << "Cannot open " << file_name << std::endl;
+		return false;
+	}
+	std::string line, field;
+	if(!std::getline(ifs, line)) return false;
+	std::istringstream header(line);
+	while(std::getline(header, field, ',')) stats.names.push_back(field);
+	stats.columns.assign(stats.names.size(), std::vector<double>());
+	while(std::getline(ifs, line))
+	{
+		if(line.empty()) continue;
+		std::istringstream row(line);
+		for(size_t i = 0; i < stats.names.size(); ++i)
+		{
+			if(!std::getline(row, field, ',')) return false;
+			stats.columns[i].push_back(std::atof(field.c_str()));
+		}
+	}
+	return (!stats.names.empty() && !stats.columns[0].empty());
+}
+
+// This function linearly interpolates a column at time t, which is clamped
+// into the time range of the file.
+double interpolate(const std::vector<double>& times, const std::vector<double>& values, double t)
+{
+	if(t <= times.front()) return values.front();
+	if(t >= times.back()) return values.back();
+	size_t k = 1;
+	while(times[k] < t) ++k;
+	double s = (t - times[k - 1]) / (times[k] - times[k - 1]);
+	return values[k - 1] * (1 - s) + values[k] * s;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <cell-stats-A.csv> <cell-stats-B.csv> [tolerance]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	double tolerance = (argc > 3 ? std::atof(argv[3]) : default_tolerance);
+	CellStatistics a, b;
+	if(!readCellStatistics(argv[1], a) || !readCellStatistics(argv[2], b)) return EXIT_FAILURE;
+	if(a.names != b.names)
+	{
+		std::cerr << "The columns of the files differ." << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::vector<double>& times = a.columns[0];
+	bool passed = true;
+	for(size_t i = 1; i < a.names.size(); ++i)
+	{
+		double sum = 0, max_diff = 0;
+		for(size_t n = 0; n < times.size(); ++n)
+		{
+			double va = a.columns[i][n];
+			double vb = interpolate(b.columns[0], b.columns[i], times[n]);
+			double diff = std::fabs(va - vb) / std::fmax(std::fabs(va), relative_difference_floor);
+			sum += diff;
+			if(diff > max_diff) max_diff = diff;
+		}
+		double mean_diff = sum / times.size();
+		bool column_passed = (mean_diff <= tolerance);
+		std::cout << std::left << std::setw(18) << a.names[i] << std::right << std::scientific << std::setprecision(2);
+		std::cout << "  mean rel " << mean_diff << "  max rel " << max_diff;
+		std::cout << "  " << (column_passed ? "ok" : "FAILED") << std::endl;
+		passed &= column_passed;
+	}
+	std::cout << (passed ? "The spreading statistics are equivalent." : "The spreading statistics differ.") << std::endl;
+	return (passed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
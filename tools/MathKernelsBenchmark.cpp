@@ -0,0 +1,113 @@
+//
+// This program validates the fast math kernels against the standard library
+// over the ranges of their arguments on the hot paths of the simulation. For
+// each kernel it reports the maximum absolute and relative errors of the fast
+// version and the time per call of both versions, both for independent calls
+// and for a chain of calls where each argument depends on the previous
+// result, which is how the simulation calls the kernels.
+//
+#include <cfloat>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <mathKernels.hpp>
+
+namespace
+{
+
+const size_t sample_size = 1 << 20;
+
+const size_t repeat_times = 20;
+
+// The relative error is measured wherever the exact value is a normal
+// number, so that the underflowing tail of the exponentials is checked too.
+const double relative_error_floor = DBL_MIN;
+
+template <typename Function>
+double timeKernel(Function f, const std::vector<double>& args)
+{
+	// The kernels are applied to independent arguments as in the loops
+	// of the simulation, so that they may be pipelined or vectorized.
+	std::vector<double> results(args.size());
+	volatile double sink = 0;
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	for(size_t n = 0; n < repeat_times; ++n)
+	{
+		for(size_t i = 0; i < args.size(); ++i) results[i] = f(args[i]);
+		sink = sink + results[n];
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - begin).count() / (repeat_times * args.size());
+}
+
+template <typename Function>
+double timeKernelChain(Function f, const std::vector<double>& args)
+{
+	// Each call waits for the result of the previous one, as the scalar
+	// calls of the simulation do, so the latency of a call is measured.
+	// The dependency adds a zero to the argument.
+	volatile double sink = 0;
+	double y = 0;
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	for(size_t n = 0; n < repeat_times; ++n)
+	{
+		for(size_t i = 0; i < args.size(); ++i) y = f(args[i] + 0 * y);
+	}
+	sink = sink + y;
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - begin).count() / (repeat_times * args.size());
+}
+
+template <typename Exact, typename Fast>
+bool validateKernel(const std::string& name, double lower, double upper, Exact exact, Fast fast, double tolerance)
+{
+	std::mt19937 engine(12345);
+	std::uniform_real_distribution<double> uniform(lower, upper);
+	std::vector<double> args(sample_size);
+	for(size_t i = 0; i < sample_size; ++i) args[i] = uniform(engine);
+	// The end points of the range are always checked.
+	args[0] = lower;
+	args[1] = upper;
+	double max_abs_error = 0, max_rel_error = 0;
+	for(size_t i = 0; i < sample_size; ++i)
+	{
+		double y = exact(args[i]);
+		double error = std::fabs(fast(args[i]) - y);
+		if(error > max_abs_error) max_abs_error = error;
+		if(std::fabs(y) > relative_error_floor && error / std::fabs(y) > max_rel_error) max_rel_error = error / std::fabs(y);
+	}
+	double exact_time = timeKernel(exact, args);
+	double fast_time = timeKernel(fast, args);
+	double exact_chain_time = timeKernelChain(exact, args);
+	double fast_chain_time = timeKernelChain(fast, args);
+	bool passed = (max_rel_error <= tolerance);
+	std::cout << std::left << std::setw(18) << name << std::right << std::scientific << std::setprecision(2);
+	std::cout << "  [" << std::setw(9) << lower << ", " << std::setw(9) << upper << "]";
+	std::cout << "  abs " << max_abs_error << "  rel " << max_rel_error;
+	std::cout << std::fixed << std::setprecision(2) << "  exact " << std::setw(6) << exact_time << " ns  fast " << std::setw(6) << fast_time << " ns";
+	std::cout << "  chained exact " << std::setw(6) << exact_chain_time << " ns  fast " << std::setw(6) << fast_chain_time << " ns";
+	std::cout << "  " << (passed ? "ok" : "FAILED") << std::endl;
+	return passed;
+}
+
+}
+
+int main()
+{
+	using namespace simulation;
+	const double tolerance = 1e-10;
+	bool passed = true;
+	passed &= validateKernel("boltzmannFactor", 0, 60, [](double x) { return exact::boltzmannFactor(x); }, [](double x) { return fast::boltzmannFactor(x); }, tolerance);
+	passed &= validateKernel("exp", -50, 0, [](double x) { return exact::exp(x); }, [](double x) { return fast::exp(x); }, tolerance);
+	passed &= validateKernel("log", 1e-12, 1, [](double x) { return exact::log(x); }, [](double x) { return fast::log(x); }, tolerance);
+	passed &= validateKernel("sin", -2 * M_PI, 2 * M_PI, [](double x) { double s, c; exact::sincos(x, s, c); return s; }, [](double x) { double s, c; fast::sincos(x, s, c); return s; }, tolerance);
+	passed &= validateKernel("cos", -2 * M_PI, 2 * M_PI, [](double x) { double s, c; exact::sincos(x, s, c); return c; }, [](double x) { double s, c; fast::sincos(x, s, c); return c; }, tolerance);
+	passed &= validateKernel("tan", -1.5, 1.5, [](double x) { return exact::tan(x); }, [](double x) { return fast::tan(x); }, tolerance);
+	passed &= validateKernel("asin", -1, 1, [](double x) { return exact::asin(x); }, [](double x) { return fast::asin(x); }, tolerance);
+	std::cout << (passed ? "All kernels are within the tolerance." : "Some kernels exceed the tolerance.") << std::endl;
+	return (passed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,104 @@
+//
+// This program regenerates the OFF-format geometry files of cell membrane
+// from a binary trajectory file written with trajectory_format=binary. The
+// first and the last frames are named with the suffixes "-start" and "-end"
+// and the others with their time, as the files written by the simulation
+// with trajectory_format=off.
+//
+// Usage: TrajectoryConverter [-l] [-f frame] <trajectory.trj> [output prefix]
+//
+//   -l        lists the frames instead of converting them.
+//   -f frame  converts only the given frame, counted from zero.
+//
+// The output prefix defaults to the name of the trajectory file without its
+// extension.
+//
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <TrajectoryFile.hpp>
+
+namespace
+{
+
+void usage(const char* program)
+{
+	std::cerr << "Usage: " << program << " [-l] [-f frame] <trajectory.trj> [output prefix]" << std::endl;
+	std::exit(EXIT_FAILURE);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace motility;
+	bool list_flag = false;
+	bool single_frame_flag = false;
+	size_t single_frame = 0;
+	std::string trajectory_filename, prefix;
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if(arg == "-l") list_flag = true;
+		else if(arg == "-f")
+		{
+			if(++i >= argc) usage(argv[0]);
+			single_frame_flag = true;
+			single_frame = std::strtoul(argv[i], 0, 10);
+		}
+		else if(trajectory_filename.empty()) trajectory_filename = arg;
+		else if(prefix.empty()) prefix = arg;
+		else usage(argv[0]);
+	}
+	if(trajectory_filename.empty()) usage(argv[0]);
+	if(prefix.empty()) prefix = trajectory_filename.substr(0, trajectory_filename.rfind('.'));
+	TrajectoryReader reader;
+	if(!reader.open(trajectory_filename))
+	{
+		std::cerr << trajectory_filename << " is not a trajectory file." << std::endl;
+		return EXIT_FAILURE;
+	}
+	size_t n_frame = reader.getFrameSize();
+	TrajectoryFrame frame;
+	if(list_flag)
+	{
+		for(size_t k = 0; k < n_frame; ++k)
+		{
+			if(!reader.read(k, frame)) return EXIT_FAILURE;
+			std::cout << "#" << k << " at " << frame.time << " sec: " << frame.getVertexSize() << " vertices, " << frame.getFacetSize() << " facets" << std::endl;
+		}
+		return EXIT_SUCCESS;
+	}
+	size_t first = (single_frame_flag ? single_frame : 0);
+	size_t last = (single_frame_flag ? single_frame + 1 : n_frame);
+	if(last > n_frame)
+	{
+		std::cerr << "The trajectory has only " << n_frame << " frames." << std::endl;
+		return EXIT_FAILURE;
+	}
+	for(size_t k = first; k < last; ++k)
+	{
+		if(!reader.read(k, frame))
+		{
+			std::cerr << "Frame #" << k << " is corrupted." << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::stringstream strs;
+		strs << prefix << '-';
+		if(k == 0) strs << "start";
+		else if(k + 1 == n_frame) strs << "end";
+		else strs << frame.time << 's';
+		strs << ".off";
+		std::ofstream output(strs.str().c_str());
+		if(!output.is_open())
+		{
+			std::cerr << "Failed to write to " << strs.str() << std::endl;
+			return EXIT_FAILURE;
+		}
+		frame.exportGeometry(output);
+		std::cout << "Writing " << strs.str() << std::endl;
+	}
+	return EXIT_SUCCESS;
+}